@@ -22,6 +22,8 @@ void MyApp::setup() {
   mTextureWhite = gl::Texture2d::create(loadImage(path + "white.png"));
   // set black stone texture
   mTextureBlack = gl::Texture2d::create(loadImage(path + "black.png"));
+  // load opening book, positions not in the book are searched
+  AlphaBeta.LoadOpeningBook(path + "opening.book");
   // set windows size
   setWindowSize(mTextureBoard.get()->getSize());
   // set mouse position
@@ -55,9 +57,53 @@ void MyApp::setup() {
   mMessage->setSize(vec2(200, 200));
   // initialize latest places stone flash count.
   mFlashCount = 0;
+  // no engine search is running
+  mSearch = SearchHandle();
+  mPonder = SearchHandle();
+  mPonderPlayer = Stone::EMPTY;
+}
+void MyApp::onRestart() {
+  // the searched game is over, do not wait for the search to return
+  AlphaBeta.CancelSearch(mSearch);
+  AlphaBeta.CancelSearch(mPonder);
+  mSearch = SearchHandle();
+  mPonder = SearchHandle();
+  game.Reset();
 }
-void MyApp::onRestart() { game.Reset(); }
 void MyApp::onExit() { exit(0); }
+void MyApp::updateSearch(Stone player, bool multi_thread) {
+  // search in background, so that the window keeps drawing meanwhile
+  if (!mSearch.IsValid()) {
+    // a ponder hit keeps pondering as the search, a miss stops it
+    mSearch =
+        AlphaBeta.AlphaBetaGoAsync(game.mChessStatus, player, multi_thread);
+    mPonder = SearchHandle();
+    return;
+  }
+  if (!AlphaBeta.IsSearchReady(mSearch)) return;
+  int x, y;
+  int result = AlphaBeta.TakeSearchResult(mSearch, x, y);
+  mSearch = SearchHandle();
+  if (result > 0) {
+    game.Play(x, y);
+    startPondering(multi_thread);
+    mFlashX = x;
+    mFlashY = y;
+    mFlashCount = 75;
+  } else
+    game.Reset();
+}
+void MyApp::startPondering(bool multi_thread) {
+  // only a human opponent leaves time to think, other players move at once
+  int selection =
+      game.GetRole() == Stone::BLACK ? mBlackSelection : mWhiteSelection;
+  if (selection == 0) {
+    mPonder = AlphaBeta.StartPondering(game.mChessStatus, game.GetRole(),
+                                       multi_thread);
+    mPonderPlayer =
+        game.GetRole() == Stone::BLACK ? Stone::WHITE : Stone::BLACK;
+  }
+}
 void MyApp::mouseMove(MouseEvent event) {
   // convert mouse position to board grid index
   int row_index = (int)((double)event.getPos().x - OFFSETX) / SIZEXY;
@@ -97,6 +143,20 @@ void MyApp::mouseDown(MouseEvent event) {
   }
 }
 void MyApp::update() {
+  // the player searched for is no longer an engine, drop its search
+  int selection =
+      game.GetRole() == Stone::BLACK ? mBlackSelection : mWhiteSelection;
+  if (mSearch.IsValid() && selection != 2 && selection != 3) {
+    AlphaBeta.CancelSearch(mSearch);
+    mSearch = SearchHandle();
+  }
+  // likewise for the player pondering while its opponent thinks
+  int ponder_selection =
+      mPonderPlayer == Stone::BLACK ? mBlackSelection : mWhiteSelection;
+  if (mPonder.IsValid() && ponder_selection != 2 && ponder_selection != 3) {
+    AlphaBeta.CancelSearch(mPonder);
+    mPonder = SearchHandle();
+  }
   // if currently does not need to flash latest stone
   if (mFlashCount == 0) {
     int x, y;
@@ -112,24 +172,10 @@ void MyApp::update() {
                       rand() % Game::BOARD_SIZE);  // NOLINT
             break;
           case 2:  // MinMax
-            if (AlphaBeta.AlphaBetaGo(game.mChessStatus, Stone::BLACK, x, y) >
-                0) {
-              game.Play(x, y);
-              mFlashX = x;
-              mFlashY = y;
-              mFlashCount = 75;
-            } else
-              game.Reset();
+            updateSearch(Stone::BLACK, false);
             break;
           case 3:  // MinMax multiple thread
-            if (AlphaBeta.AlphaBetaGoMT(game.mChessStatus, Stone::BLACK, x, y) >
-                0) {
-              game.Play(x, y);
-              mFlashX = x;
-              mFlashY = y;
-              mFlashCount = 75;
-            } else
-              game.Reset();
+            updateSearch(Stone::BLACK, true);
             break;
           case 4:  // simple auto player
             if (SimpleAutoPlayer::SimpleStrategy(game.mChessStatus,
@@ -153,24 +199,10 @@ void MyApp::update() {
                       rand() % Game::BOARD_SIZE);  // NOLINT
             break;
           case 2:  // MinMax
-            if (AlphaBeta.AlphaBetaGo(game.mChessStatus, Stone::WHITE, x, y) >
-                0) {
-              game.Play(x, y);
-              mFlashX = x;
-              mFlashY = y;
-              mFlashCount = 75;
-            } else
-              game.Reset();
+            updateSearch(Stone::WHITE, false);
             break;
           case 3:  // MinMax multiple thread
-            if (AlphaBeta.AlphaBetaGoMT(game.mChessStatus, Stone::WHITE, x, y) >
-                0) {
-              game.Play(x, y);
-              mFlashX = x;
-              mFlashY = y;
-              mFlashCount = 75;
-            } else
-              game.Reset();
+            updateSearch(Stone::WHITE, true);
             break;
           case 4:  // simple auto player
             if (SimpleAutoPlayer::SimpleStrategy(game.mChessStatus,
@@ -65,6 +65,18 @@ class MyApp : public App {
    * @param winner winner stone type.
    */
   static void drawWinner(Stone winner);
+  /**
+   * start the engine search of current player, or play its move once the
+   * search returns. Never waits for the search.
+   * @param player current player.
+   * @param multi_thread whether the engine searches with multiple thread.
+   */
+  void updateSearch(Stone player, bool multi_thread);
+  /**
+   * search the predicted reply while a human opponent is thinking.
+   * @param multi_thread whether the engine searches with multiple thread.
+   */
+  void startPondering(bool multi_thread);
 
  private:
   Game game;                     // new game instance
@@ -76,11 +88,14 @@ class MyApp : public App {
   params::InterfaceGlRef mParams;   // parameter window
   params::InterfaceGlRef mMessage;  // message window
 
-  int mShowPosX;    // highlighted circle x coordinate
-  int mShowPosY;    // highlighted circle y coordinate
-  int mFlashX;      // latest placed stone x coordinate
-  int mFlashY;      // latest placed stone y coordinate
-  int mFlashCount;  // latest placed stone flash count
+  int mShowPosX;         // highlighted circle x coordinate
+  int mShowPosY;         // highlighted circle y coordinate
+  int mFlashX;           // latest placed stone x coordinate
+  int mFlashY;           // latest placed stone y coordinate
+  int mFlashCount;       // latest placed stone flash count
+  SearchHandle mSearch;  // engine search running in background, if valid
+  SearchHandle mPonder;  // pondering search of the engine, if valid
+  Stone mPonderPlayer;   // player the pondering search moves for
 
   std::vector<std::string> mBlackPlayers;  // black side player choice list
   int mBlackSelection;                     // black side player choice index
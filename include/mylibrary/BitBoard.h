@@ -0,0 +1,146 @@
+//
+// Bitboard representation of gomoku board status.
+//
+
+#ifndef FINALPROJECT_BITBOARD_H
+#define FINALPROJECT_BITBOARD_H
+
+#include <cstdint>
+
+#include "Stone.h"
+
+/**
+ * board stored as one bit mask per line and per color.
+ *
+ * every stone is kept in four orientations: row-major, column-major,
+ * diagonal-major and anti-diagonal-major, so that each line of the board
+ * is a single word. Five in a row is found by and-ing a line with itself
+ * shifted, and the grids near a stone by or-ing shifted lines (dilation).
+ * the board has N x N grids and is won by K in a row.
+ */
+template <int N, int K>
+class BasicBitBoard {
+  static_assert(N < 32, "a line of the board must fit a 32 bit word");
+
+ public:
+  // number of diagonals (or anti-diagonals) on the board
+  static const int DIAGONAL_NUM = 2 * N - 1;
+  // mask with one bit for every grid of a row
+  static const uint32_t LINE_MASK = (1U << N) - 1U;
+
+  /**
+   * create empty board
+   */
+  BasicBitBoard();
+  /**
+   * create bitboard from board status
+   * @param board board status
+   */
+  explicit BasicBitBoard(Stone board[N][N]);
+  /**
+   * remove all stones
+   */
+  void Clear();
+  /**
+   * place a stone on empty grid
+   * @param x row coordinate
+   * @param y column coordinate
+   * @param stone stone type (black or white)
+   */
+  void Place(int x, int y, Stone stone);
+  /**
+   * remove a stone
+   * @param x row coordinate
+   * @param y column coordinate
+   * @param stone stone type at the grid
+   */
+  void Remove(int x, int y, Stone stone);
+  /**
+   * get the stone at given position
+   * @param x row coordinate
+   * @param y column coordinate
+   * @return stone type at given position
+   */
+  Stone Get(int x, int y) const;
+  /**
+   * check whether the stone at given position is part of five in a row
+   * @param x row coordinate
+   * @param y column coordinate
+   * @return whether the stone wins
+   */
+  bool IsWin(int x, int y) const;
+  /**
+   * check whether there's a stone within range of given position
+   * @param x row coordinate
+   * @param y column coordinate
+   * @param range distance in both coordinates
+   * @return whether any grid within range is occupied
+   */
+  bool HasNeighbor(int x, int y, int range) const;
+  /**
+   * get every empty grid that has a stone within range
+   * @param range distance in both coordinates
+   * @param neighbors row masks, bit y of neighbors[x] is set for grid (x, y)
+   */
+  void GetNeighbors(int range, uint32_t neighbors[N]) const;
+  /**
+   * get the stones of one line
+   * @param stone stone type (black or white)
+   * @param dir direction (row, column, diagonal, anti-diagonal)
+   * @param index line index, see storage below
+   * @return line mask
+   */
+  uint32_t GetLine(Stone stone, int dir, int index) const;
+  /**
+   * get the grids of one line that are on the board
+   * @param dir direction (row, column, diagonal, anti-diagonal)
+   * @param index line index
+   * @return line mask
+   */
+  static uint32_t GetLineMask(int dir, int index);
+  /**
+   * get the number of lines in given direction
+   * @param dir direction (row, column, diagonal, anti-diagonal)
+   * @return number of lines
+   */
+  static int GetLineNum(int dir) {
+    return dir < 2 ? N : DIAGONAL_NUM;
+  }
+  /**
+   * get the grid of a bit of a line
+   * @param dir direction (row, column, diagonal, anti-diagonal)
+   * @param index line index
+   * @param bit bit index
+   * @param x row coordinate reference
+   * @param y column coordinate reference
+   */
+  static void GetLineGrid(int dir, int index, int bit, int& x, int& y);
+
+ private:
+  /**
+   * check whether a run of K set bits in the line covers given bit
+   * @param line line mask
+   * @param bit bit index
+   * @return whether the line has K in a row through the bit
+   */
+  static bool HasFive(uint32_t line, int bit);
+  /**
+   * spread every set bit of the line to the bits within range
+   * @param line line mask
+   * @param range distance
+   * @return dilated line mask
+   */
+  static uint32_t Dilate(uint32_t line, int range);
+
+ private:
+  // bit y of rows[c][x] is grid (x, y), c is 0 for black and 1 for white
+  uint32_t rows[2][N];
+  // bit x of columns[c][y] is grid (x, y)
+  uint32_t columns[2][N];
+  // bit x of diagonals[c][x - y + BOARD_SIZE - 1] is grid (x, y)
+  uint32_t diagonals[2][DIAGONAL_NUM];
+  // bit x of anti_diagonals[c][x + y] is grid (x, y)
+  uint32_t anti_diagonals[2][DIAGONAL_NUM];
+};
+
+#endif  // FINALPROJECT_BITBOARD_H
@@ -0,0 +1,62 @@
+//
+// Candidate moves maintained incrementally during search.
+//
+
+#ifndef FINALPROJECT_CANDIDATESET_H
+#define FINALPROJECT_CANDIDATESET_H
+
+#include <cstdint>
+
+#include "Game.h"
+
+/**
+ * set of empty grids within given range of any stone.
+ *
+ * every grid counts the stones within range of it. Placing or removing a
+ * stone only updates the counts around that stone, a grid is a candidate
+ * while it is empty and its count is positive. The board has N x N grids.
+ */
+template <int N>
+class BasicCandidateSet {
+ public:
+  /**
+   * create empty set
+   */
+  BasicCandidateSet();
+  /**
+   * rebuild the set from board status
+   * @param board board status
+   * @param range distance in both coordinates
+   */
+  void Init(Stone board[N][N], int range);
+  /**
+   * update the set after a stone is placed
+   * @param x row coordinate
+   * @param y column coordinate
+   */
+  void Place(int x, int y);
+  /**
+   * update the set after a stone is removed
+   * @param x row coordinate
+   * @param y column coordinate
+   */
+  void Remove(int x, int y);
+  /**
+   * get candidates of a row
+   * @param x row coordinate
+   * @return row mask, bit y is set when grid (x, y) is a candidate
+   */
+  uint32_t GetRow(int x) const { return rows[x]; }
+
+ private:
+  // distance in both coordinates
+  int range;
+  // number of stones within range of each grid
+  uint8_t count[N][N];
+  // bit y of occupied[x] is set when grid (x, y) has a stone
+  uint32_t occupied[N];
+  // bit y of rows[x] is set when grid (x, y) is a candidate
+  uint32_t rows[N];
+};
+
+#endif  // FINALPROJECT_CANDIDATESET_H
@@ -5,14 +5,20 @@
 #ifndef FINALPROJECT_GAME_H
 #define FINALPROJECT_GAME_H
 
-enum Stone { EMPTY, BLACK, WHITE };
+#include "BitBoard.h"
+#include "Stone.h"
 
-class Game {
+/**
+ * gomoku game on a board of N x N grids, won by K stones in a row.
+ * instantiated for the variants of FOR_EACH_BOARD_VARIANT
+ */
+template <int N, int K>
+class BasicGame {
  public:
-  // standard board size.
-  static const int BOARD_SIZE = 19;
+  // board size.
+  static const int BOARD_SIZE = N;
   // number of consecutive stone needed to win
-  static const int WINNING_THRESHOLD = 5;
+  static const int WINNING_THRESHOLD = K;
   // current winner
   Stone mWinner;
   // current player
@@ -21,7 +27,7 @@ class Game {
   Stone mChessStatus[BOARD_SIZE][BOARD_SIZE];
 
  public:
-  Game();
+  BasicGame();
   void Reset();
   /**
    * place a stone at given position
@@ -42,45 +48,14 @@ class Game {
    * @return current player type.
    */
   Stone GetRole();
-  /**
-   * check winner for the game. Since we check winner for every step, this
-   * function only goes through the column, row, and two diagonals containing
-   * latest position.
-   * @param x  row coordinate
-   * @param y  column coordinate
-   * @return  whether current winner wins.
-   */
-  static bool IsWin(Stone board[BOARD_SIZE][BOARD_SIZE], int x, int y);
 
  private:
-  /**
-   * check whether current column contains winner.
-   * @param x row coordinate
-   * @param y column coordinate
-   * @return whether has winner
-   */
-  static bool IsColumnWin(Stone board[BOARD_SIZE][BOARD_SIZE], int x, int y);
-  /**
-   * check whether current row contains winner.
-   * @param x row coordinate
-   * @param y column coordinate
-   * @return whether has winner
-   */
-  static bool IsRowWin(Stone board[BOARD_SIZE][BOARD_SIZE], int x, int y);
-  /**
-   * check whether current diagonal contains winner.
-   * @param x row coordinate
-   * @param y column coordinate
-   * @return whether has winner
-   */
-  static bool IsDiagonalWin(Stone board[BOARD_SIZE][BOARD_SIZE], int x, int y);
-  /**
-   * check whether current anti-diagonal contains winner.
-   * @param x row coordinate
-   * @param y column coordinate
-   * @return whether has winner
-   */
-  static bool IsAntiDiagonalWIn(Stone board[BOARD_SIZE][BOARD_SIZE], int,
-                                int y);
+  // bitboard of mChessStatus, kept in step by Play and Reset, so the
+  // board must not be written directly. It checks the winner of every move
+  BasicBitBoard<N, K> mBitBoard;
 };
+
+// standard game, played by the app
+using Game = BasicGame<19, 5>;
+
 #endif  // FINALPROJECT_GAME_H
@@ -0,0 +1,78 @@
+//
+// Pattern scoring of many board lines at once.
+//
+
+#ifndef FINALPROJECT_LINESCORER_H
+#define FINALPROJECT_LINESCORER_H
+
+#include "Game.h"
+
+/**
+ * scores board lines with the pattern table, for both players at once.
+ *
+ * the score of a line is the best score among every 7 consecutive grids of
+ * it, like the line scan of the evaluation. On x86 processors with AVX2, 8
+ * lines are scanned together in vector lanes: the grids are gathered from
+ * the board through a line layout, and the windows are gathered from the
+ * pattern table. The instruction set is checked at run time, other
+ * processors, and lines left over from groups of 8, use the scalar scan.
+ * @tparam N board size
+ */
+template <int N>
+class BasicLineScorer {
+ public:
+  // number of board lines: rows, columns, diagonals and anti-diagonals
+  static const int LINE_NUM = 2 * N + 2 * (2 * N - 1);
+  // first line of each direction, in the order of row, column, diagonal and
+  // anti-diagonal. A line is indexed like the lines of ScoreCache
+  static constexpr int LINE_OFFSET[4] = {0, N, 2 * N, 4 * N - 1};
+
+  /**
+   * best pattern score and type of scored lines, for black and white.
+   * player index 0 is black, 1 is white
+   */
+  struct Scores {
+    int score[2][LINE_NUM];
+    int type[2][LINE_NUM];
+  };
+
+  /**
+   * score given lines of the board
+   * @param board board status
+   * @param lines line indices, see LINE_OFFSET
+   * @param count number of lines
+   * @param scores line scores, written at the index of each line
+   */
+  static void ScoreLines(Stone board[N][N], const int* lines, int count,
+                         Scores* scores);
+  /**
+   * score all lines of the board
+   * @param board board status
+   * @param scores line scores
+   */
+  static void ScoreBoard(Stone board[N][N], Scores* scores);
+  /**
+   * @return whether the lines are scored by the AVX2 kernel
+   */
+  static bool IsVectorized();
+  /**
+   * force the scalar scan, used to compare both kernels. It applies to
+   * every board size, set it before any search starts
+   * @param scalar whether to use the scalar scan on every processor
+   */
+  static void SetScalar(bool scalar);
+
+ private:
+  static void ScoreLinesScalar(Stone board[N][N], const int* lines, int count,
+                               Scores* scores);
+  static void ScoreLinesAvx2(Stone board[N][N], const int* lines, int count,
+                             Scores* scores);
+};
+
+template <int N>
+constexpr int BasicLineScorer<N>::LINE_OFFSET[4];
+
+// line scorer of the standard board
+using LineScorer = BasicLineScorer<Game::BOARD_SIZE>;
+
+#endif  // FINALPROJECT_LINESCORER_H
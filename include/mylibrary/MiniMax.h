@@ -5,15 +5,29 @@
 #ifndef FINALPROJECT_MINIMAX_H
 #define FINALPROJECT_MINIMAX_H
 
-#include <Windows.h>
-
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
 #include <tuple>
-// we only care about 7 consecutive stones on the board
-// each stone convert to 2 bit number, 00 , 01, or 11
-// therefore, max size would be 2^(7 * 2) = 0x3fff
-static const int BIT_DATA_LENGTH = 14;
-static const int BIT_DATA_SIZE = 0x3fff;  // NOLINT
+#include <vector>
+
+#include "BitBoard.h"
+#include "CandidateSet.h"
+#include "Game.h"
+#include "LineScorer.h"
+#include "OpeningBook.h"
+#include "PatternTable.h"
+#include "ThreadPool.h"
+#include "ThreatSolver.h"
+#include "TranspositionTable.h"
+#include "Zobrist.h"
+
 // search for empty grid within 2 unit of the occupied grid.
 // increase this value could slightly increase win rate
 // but exponentially decrease efficiency
@@ -21,79 +35,320 @@ static const int SEARCH_RANGE = 2;
 // default search depth. Increase depth will significantly increase win rate
 // while factorial increase time needed to finish computation
 static const int SEARCH_DEPTH = 3;
-// multiple-thread number, default set to be 4. No harm to be higher.
+// multiple-thread number used when hardware concurrency can not be
+// detected, otherwise one thread per hardware thread is created.
 static const int THREAD_NUM = 4;
+// number of searched nodes between two deadline checks
+static const int DEADLINE_CHECK_INTERVAL = 1024;
+// minimum remaining depth of a node whose children are searched in
+// parallel. Shallower subtrees are too small to be worth a task, and
+// siblings searched at the same time prune less than searched in order
+static const int SPLIT_MIN_DEPTH = 3;
+// score of two patterns on different lines through the same grid (or on
+// the same board). Retrieved from internet, not the best probably
+static const int DOUBLE_FOUR_SCORE = 10000;  // two fours, or four and three
+static const int DOUBLE_THREE_SCORE = 5000;  // two open threes
+static const int THREE_HALF_THREE_SCORE = 1000;
+static const int DOUBLE_TWO_SCORE = 100;  // two open twos
+static const int TWO_HALF_TWO_SCORE = 10;
+// maximum number of distinct point values, one bucket each when
+// candidate positions are ordered
+static const int SCORE_BUCKET_NUM = 16;
+// deepest ply that keeps killer moves
+static const int MAX_SEARCH_PLY = 64;
+// killer moves kept for every ply
+static const int KILLER_NUM = 2;
+// upper bound of a history table entry, killer moves rank above it
+static const int HISTORY_MAX = 1 << 24;
+// bound of every search score. Unlike the int minimum its negation is
+// still an int, so windows can be negated between plies
+static const int SCORE_INFINITY = std::numeric_limits<int>::max();
+// half width of the window around the previous iteration score that
+// root moves are searched with
+static const int ASPIRATION_WINDOW = 100;
+// plies of forcing moves searched below a leaf before it is evaluated
+static const int QUIESCENCE_DEPTH = 4;
+// nodes searched below one leaf at most, the rest are evaluated
+static const int QUIESCENCE_NODE_LIMIT = 16;
+// minimum remaining depth of a node whose late moves are reduced
+static const int LMR_MIN_DEPTH = 2;
+// number of candidates of a node searched at full depth before reducing
+static const int LMR_FULL_MOVES = 2;
+// depth taken off a late quiet move, and off moves after LMR_DEEP_MOVES
+static const int LMR_REDUCTION = 1;
+static const int LMR_DEEP_REDUCTION = 2;
+static const int LMR_DEEP_MOVES = 8;
+// largest gain of a quiet move at a frontier node. A quiet move adds at
+// most a half-open three, that combines with an open three to
+// THREE_HALF_THREE_SCORE. Blocking an open three gains less
+static const int FUTILITY_MARGIN = 1000;
+// deepest remaining depth whose quiet moves are pruned by the static score.
+// The margin is not scaled with depth, quiet moves of both players mostly
+// cancel out
+static const int FUTILITY_DEPTH = 3;
+// score of a position won by continuous threats, below five in a row and
+// above every other pattern
+static const int THREAT_WIN_SCORE = 500000;
+// deepest victory by continuous threats probed at leaves, attacker moves
+static const int LEAF_VCT_DEPTH = 2;
+// searched node budget of one leaf probe
+static const long long LEAF_VCT_NODE_LIMIT = 64;
+// added to a leaf whose player to move has an open three the opponent can
+// not answer with a four, when the probe does not prove the win
+static const int LEAF_THREE_BONUS = 200;
+// set to 1 to compare the incrementally updated score caches with a full
+// board scan at every leaf. Very slow, only used for debugging
+#ifndef CHECK_INCREMENTAL_EVALUATION
+#define CHECK_INCREMENTAL_EVALUATION 0
+#endif
+// stones in a row the pattern table and the evaluation are written for
+static const int EVALUATION_WIN_LENGTH = 5;
 
 /**
- * all gomoku stone patterns that can contribute to winning.
+ * score cache used to store highest score in each
+ * row, column, diagonal, anti-diagonal score and pattern type
+ *
+ * number of lines of each pattern type is kept for every direction, so that
+ * the best pattern of the board is found without scanning all lines.
+ * @tparam N board size
+ */
+template <int N>
+struct BasicScoreCache {
+  int horizontal_score[N];
+  int horizontal_type[N];
+  int vertical_score[N];
+  int vertical_type[N];
+  int diagonal_score[2 * N - 1];
+  int diagonal_type[2 * N - 1];
+  int antiDiagonal_score[2 * N - 1];
+  int antiDiagonal_type[2 * N - 1];
+  // line count by direction (row, column, diagonal, anti) and pattern type.
+  // a line without scored pattern counts as NONE
+  int type_count[4][HALF_OPEN_TWO + 1];
+};
+/**
+ * board searched by one thread, with its bitboard, candidate moves, zobrist
+ * hash and score caches. all of them are updated together when a stone is
+ * placed or removed.
+ *
+ * only the latest move can end the game, so the winner is checked on the
+ * four lines through that stone instead of scanning the whole board.
+ * @tparam N board size
+ * @tparam K number of stones in a row to win
  */
-enum PatternType {
-  NONE,
-  CONSECUTIVE_FIVE,
-  OPEN_FOUR,
-  MAKE_CONSECUTIVE_FOUR,
-  OPEN_THREE,
-  HALF_OPEN_THREE,
-  OPEN_TWO,
-  HALF_OPEN_TWO,
-  CLOSE_FOUR,
-  CLOSE_THREE,
-  CLOSE_TWO
+template <int N, int K>
+struct BasicSearchPosition {
+  Stone board[N][N];
+  BasicBitBoard<N, K> bitboard;
+  BasicCandidateSet<N> candidates;
+  BasicSymmetricHash<N> hash;  // hashes of the board and its symmetric images
+  BasicScoreCache<N> black_score_cache;
+  BasicScoreCache<N> white_score_cache;
+  int last_x;    // row index of the latest move, -1 if none
+  int last_y;    // column index of the latest move, -1 if none
+  Stone winner;  // player with five in a row, EMPTY if game is not over
+  int ply;       // number of moves made since the root
+  // latest moves causing a cutoff at each ply, x * N + y,
+  // -1 if none. Most recent first
+  int killers[MAX_SEARCH_PLY][KILLER_NUM];
 };
 /**
- * pattern struct used to store char pattern
- * and corresponding score and type enum.
+ * score and type of the four lines through a point before a move,
+ * so that the move can be taken back without scanning the lines again.
+ * index by color (black, white) and direction (row, column, diagonal, anti).
  */
-struct Pattern {
-  char string_pattern[BIT_DATA_LENGTH / 2 + 1];
-  int score;
-  int type;
+struct MoveUndo {
+  int score[2][4];
+  int type[2][4];
+  int last_x;
+  int last_y;
+  Stone winner;
 };
 /**
- * score cache used to store highest score in each
- * row, column, diagonal, anti-diagonal score and pattern type
+ * budget of one AlphaBetaGo or AlphaBetaGoMT call. Search deepens one
+ * level at a time until max depth is reached or the budget runs out.
+ */
+struct SearchLimits {
+  int max_depth = SEARCH_DEPTH;  // deepest iteration to search
+  int time_limit_ms = 0;         // wall-clock budget, 0 for unlimited
+  long long node_limit = 0;      // searched node budget, 0 for unlimited
+  int quiescence_depth = QUIESCENCE_DEPTH;  // plies of forcing moves below
+                                            // the deepest iteration
+};
+/**
+ * statistics of the latest AlphaBetaGo or AlphaBetaGoMT call
+ */
+struct SearchStatistics {
+  long long tt_hits;    // transposition table probe found the position
+  long long tt_misses;  // transposition table probe missed the position
+  long long nodes;      // number of searched nodes
+  int completed_depth;  // depth of the last finished iteration
+  int best_value;       // score of the returned move
+  bool winning_move;    // returned move makes five in a row, no search done
+  bool forced_move;     // returned move blocks a five or starts a forced
+                        // win by continuous fours, no search done
+  long long threat_nodes;  // number of nodes searched by threat solver
+  bool book_move;          // returned move is from the opening book, no
+                           // search done
+  bool ponder_hit;         // search started while pondering, the
+                           // opponent played the predicted reply
+  long long reduced_moves;       // moves searched at reduced depth
+  long long reduction_failures;  // reduced moves searched again at full depth
+  long long futility_prunes;     // frontier moves skipped by futility pruning
+  long long quiescence_nodes;    // nodes searched below the leaves, part of
+                                 // nodes
+};
+/**
+ * progress of a background search started by AlphaBetaGoAsync or
+ * StartPondering, readable while it runs
+ */
+struct SearchProgress {
+  bool searching;       // a search is started and its move not taken yet
+  bool done;            // search returned, its move is taken without waiting
+  bool pondering;       // searching the predicted reply of the opponent
+  int completed_depth;  // depth of the last finished iteration, 0 if none
+  int best_value;       // score of the best move of that iteration
+  int row_index;        // best move of that iteration, -1 if none
+  int column_index;     // best move of that iteration, -1 if none
+  long long nodes;      // number of nodes searched so far
+};
+/**
+ * handle of one background search, returned by AlphaBetaGoAsync and
+ * StartPondering. On a ponder hit, AlphaBetaGoAsync returns the handle of
+ * the pondering search. An engine runs one background search at a time,
+ * so starting another one makes the handle stale: it is ready at once and
+ * takes no move
  */
-struct ScoreCache {
-  int horizontal_score[Game::BOARD_SIZE];
-  int horizontal_type[Game::BOARD_SIZE];
-  int vertical_score[Game::BOARD_SIZE];
-  int vertical_type[Game::BOARD_SIZE];
-  int diagonal_score[2 * Game::BOARD_SIZE - 1];
-  int diagonal_type[2 * Game::BOARD_SIZE - 1];
-  int antiDiagonal_score[2 * Game::BOARD_SIZE - 1];
-  int antiDiagonal_type[2 * Game::BOARD_SIZE - 1];
+struct SearchHandle {
+  long long id = 0;  // number of the search, 0 for no search
+  /**
+   * @return whether the handle refers to a search
+   */
+  bool IsValid() const { return id != 0; }
 };
 /**
- * doubly linked list used to store candidate position
+ * selective search settings. Only quiet moves are pruned or reduced: moves
+ * that make neither an open three nor better for the player to move, and
+ * are not played while the opponent has an open three or four to answer
+ */
+struct PruningOptions {
+  bool late_move_reduction = true;  // search late quiet moves shallower
+  int lmr_min_depth = LMR_MIN_DEPTH;
+  int lmr_full_moves = LMR_FULL_MOVES;
+  int lmr_reduction = LMR_REDUCTION;
+  int lmr_deep_reduction = LMR_DEEP_REDUCTION;
+  int lmr_deep_moves = LMR_DEEP_MOVES;
+  bool futility_pruning = true;  // skip quiet moves near the leaves that can
+                                 // not raise the static score to alpha
+  int futility_margin = FUTILITY_MARGIN;
+  int futility_depth = FUTILITY_DEPTH;
+};
+/**
+ * how AlphaBetaGoMT spreads the search over worker threads
+ */
+enum ParallelMode {
+  // every root move is searched by one worker
+  ROOT_SPLIT,
+  // every worker runs the whole iterative deepening search at staggered
+  // depths, workers share results through the transposition table
+  LAZY_SMP,
+  // root moves are searched one by one, inside the tree the first child
+  // of a node is searched alone and the rest are shared with workers
+  SPLIT_POINT
+};
+/**
+ * root move with the score from the latest finished iteration
+ */
+struct RootMove {
+  int row_index;
+  int column_index;
+  int value;
+};
+/**
+ * candidate position
  * (empty grid that has neighbor within 2 grid distance)
- * sorted by point value from highest to lowest.
+ * with its point value.
  */
-class CandidatePosition {
- public:
-  CandidatePosition() {
-    pNext = nullptr;
-    pPrev = nullptr;
-  }
-  CandidatePosition(int x, int y, int value) {
-    row_index = x;
-    column_index = y;
-    grid_value = value;
-    pPrev = nullptr;
-    pNext = nullptr;
+struct CandidatePosition {
+  int row_index;
+  int column_index;
+  int grid_value;
+};
+/**
+ * candidate positions of one search node sorted by point value from
+ * highest to lowest. Stored in place with room for every grid, so that
+ * a node keeps its list on the stack without any heap allocation.
+ * @tparam N board size
+ */
+template <int N>
+struct BasicCandidateList {
+  CandidatePosition positions[N * N];
+  int size;
+};
+/**
+ * node whose remaining children are searched by worker threads after its
+ * first child is searched (young brothers wait). Siblings share the window
+ * and the best result, a cutoff cancels every sibling still running.
+ */
+struct SplitPoint {
+  SplitPoint* parent;        // enclosing split point, nullptr for none
+  std::atomic<bool> cutoff;  // set once remaining siblings are not needed
+  std::mutex lock;           // guards window and best result below
+  int alpha;
+  int beta;
+  int bestValue;
+  int bestX;
+  int bestY;
+  /**
+   * @return whether this or any enclosing split point is cut off
+   */
+  bool IsCutoff() const {
+    for (const SplitPoint* p = this; p; p = p->parent)
+      if (p->cutoff.load(std::memory_order_relaxed)) return true;
+    return false;
   }
-  int row_index{}, column_index{}, grid_value{};
-  CandidatePosition *pNext, *pPrev;
 };
+template <int N, int K>
+struct BasicMinMaxThreadParam;
 /**
  * alpha-beta pruning to find best move on given board
  *
  * search range, depth, and multiple-thread number can be edit
  * on the top of this file. (adjust in accordance with computer
  * computing ability).
+ *
+ * the board has N x N grids and K stones in a row win. The evaluation only
+ * knows five in a row, so every instantiated board size has K = 5.
+ * @tparam N board size
+ * @tparam K number of stones in a row to win
  */
-class AlphaBetaAlgorithm {
+template <int N, int K>
+class BasicAlphaBetaAlgorithm {
+  static_assert(K == EVALUATION_WIN_LENGTH,
+                "pattern table only scores five in a row");
+
  public:
-  AlphaBetaAlgorithm();
+  // board types of the same size
+  using BitBoard = BasicBitBoard<N, K>;
+  using Zobrist = BasicZobrist<N>;
+  using SymmetricHash = BasicSymmetricHash<N>;
+  using ScoreCache = BasicScoreCache<N>;
+  using SearchPosition = BasicSearchPosition<N, K>;
+  using CandidateList = BasicCandidateList<N>;
+  using ThreatSolver = BasicThreatSolver<N, K>;
+  using LineScorer = BasicLineScorer<N>;
+  using MinMaxThreadParam = BasicMinMaxThreadParam<N, K>;
+
+  /**
+   * create algorithm instance and its transposition table
+   * @param table_size number of transposition table entries
+   */
+  explicit BasicAlphaBetaAlgorithm(
+      size_t table_size = TRANSPOSITION_TABLE_SIZE);
+  /**
+   * cancel pondering search, if any
+   */
+  ~BasicAlphaBetaAlgorithm();
   /**
    * alpha-beta prunning find best position to move
    * @param board board status
@@ -102,8 +357,7 @@ class AlphaBetaAlgorithm {
    * @param y column index reference. Will be updated to best column index
    * @return 1 for normal situation and 0 for no move available
    */
-  int AlphaBetaGo(Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE], Stone player,
-                  int& x, int& y);
+  int AlphaBetaGo(Stone board[N][N], Stone player, int& x, int& y);
   /**
    * alpha-beta pruning find best position to move with multiple thread
    * @param board board status
@@ -112,13 +366,251 @@ class AlphaBetaAlgorithm {
    * @param y column index reference. Will be updated to best column index
    * @return 1 for normal situation and 0 for no move available
    */
-  int AlphaBetaGoMT(Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE],
-                    Stone player, int& x, int& y);
+  int AlphaBetaGoMT(Stone board[N][N], Stone player, int& x, int& y);
+  /**
+   * start searching on a background thread and return at once, so that
+   * the caller keeps running (e.g. drawing frames) meanwhile. Poll it with
+   * IsSearchReady or GetSearchProgress, then take the move with
+   * TakeSearchResult. The time limit of the search limits is its deadline.
+   *
+   * only one search runs at a time, a previous one is stopped first unless
+   * it is pondering this position. Its handle becomes stale
+   * @param board board status, copied
+   * @param player current player
+   * @param multi_thread whether to search like AlphaBetaGoMT
+   * @return handle of the search
+   */
+  SearchHandle AlphaBetaGoAsync(Stone board[N][N], Stone player,
+                                bool multi_thread);
+  /**
+   * @param search search handle
+   * @return whether the search returned or is stale, so that
+   *         TakeSearchResult does not wait
+   */
+  bool IsSearchReady(const SearchHandle& search) const;
+  /**
+   * get the progress of a background search
+   * @param search search handle
+   * @return search progress, not searching if the handle is stale
+   */
+  SearchProgress GetSearchProgress(const SearchHandle& search) const;
+  /**
+   * move the deadline of the running search, counted from now
+   * @param time_limit_ms wall-clock budget, 0 for unlimited
+   */
+  void SetSearchDeadline(int time_limit_ms);
+  /**
+   * stop a background search early without waiting for it. The best move
+   * of its last finished iteration can still be taken. A stale handle
+   * does not stop the search that replaced it
+   * @param search search handle
+   */
+  void CancelSearch(const SearchHandle& search);
+  /**
+   * wait for a background search and take its move
+   * @param search search handle
+   * @param x row index reference. Will be updated to best row index
+   * @param y column index reference. Will be updated to best column index
+   * @return 1 for normal situation and 0 for no move available, a stale
+   *         handle or a move already taken
+   */
+  int TakeSearchResult(const SearchHandle& search, int& x, int& y);
+  /**
+   * search in background while the opponent is thinking (pondering). The
+   * reply of the opponent is predicted from the transposition table, and
+   * the position after it is searched with no time limit.
+   *
+   * the next AlphaBetaGo, AlphaBetaGoMT or AlphaBetaGoAsync call on that
+   * position (ponder hit) keeps the pondering search and gives it the
+   * normal time limit from then on. A call on any other position (ponder
+   * miss) stops it and searches from scratch, with the tables it filled.
+   * Setters stop it too, statistics are only valid once it is over.
+   * CancelSearch with the returned handle stops it without waiting
+   * @param board board status, after the move of the latest search
+   * @param opponent player to move on the board
+   * @param multi_thread whether to search like AlphaBetaGoMT
+   * @return handle of the pondering search, not valid if the game is over
+   */
+  SearchHandle StartPondering(Stone board[N][N], Stone opponent,
+                              bool multi_thread);
+  /**
+   * get the predicted reply of the pondering search
+   * @param x row index reference. Updated to predicted row index
+   * @param y column index reference. Updated to predicted column index
+   * @return whether a search is pondering
+   */
+  bool GetPonderMove(int& x, int& y) const;
+  /**
+   * change the number of transposition table entries, all stored
+   * positions are lost.
+   * @param table_size number of entries, rounded down to power of two
+   */
+  void SetTranspositionTableSize(size_t table_size);
+  /**
+   * get statistics of the latest search
+   * @return search statistics
+   */
+  SearchStatistics GetStatistics() const;
+  /**
+   * set depth, time and node budget used by following searches
+   * @param search_limits search budget
+   */
+  void SetSearchLimits(const SearchLimits& search_limits);
+  /**
+   * get current search budget
+   * @return search budget
+   */
+  SearchLimits GetSearchLimits() const;
+  /**
+   * set budget of victory by continuous threats searched at the root
+   * @param limits threat search budget
+   */
+  void SetThreatLimits(const ThreatLimits& limits);
+  /**
+   * get budget of victory by continuous threats searched at the root
+   * @return threat search budget
+   */
+  ThreatLimits GetThreatLimits() const;
+  /**
+   * choose whether leaves are probed for victory by continuous threats
+   * @param enabled whether to probe, true by default
+   */
+  void SetThreatProbe(bool enabled);
+  /**
+   * choose whether candidates of equal value are ordered by killer moves
+   * and history scores of earlier cutoffs
+   * @param enabled whether to order them, true by default
+   */
+  void SetMoveOrdering(bool enabled);
+  /**
+   * choose whether moves after the first are searched with a null window
+   * and iterations start from an aspiration window around the previous
+   * score. Without it every move is searched with the full window and no
+   * move is reduced
+   * @param enabled whether to search with narrow windows, true by default
+   */
+  void SetPrincipalVariationSearch(bool enabled);
+  /**
+   * set late move reduction and futility pruning settings
+   * @param options pruning settings
+   */
+  void SetPruningOptions(const PruningOptions& options);
+  /**
+   * get late move reduction and futility pruning settings
+   * @return pruning settings
+   */
+  PruningOptions GetPruningOptions() const;
+  /**
+   * map an opening book, probed before every following search. Positions
+   * in the book are answered without searching. A book built for another
+   * board size or win length is rejected
+   * @param path book file path
+   * @return whether the book is loaded, the previous one is closed anyway
+   */
+  bool LoadOpeningBook(const std::string& path);
+  /**
+   * choose how AlphaBetaGoMT uses worker threads
+   * @param mode parallel mode, ROOT_SPLIT by default
+   */
+  void SetParallelMode(ParallelMode mode);
+  /**
+   * set the number of threads AlphaBetaGoMT searches with, the workers
+   * are created again on the next parallel search
+   * @param threads number of threads, 0 for one per hardware thread
+   */
+  void SetThreadNum(int threads);
+  /**
+   * seed the generator shuffling root moves of equal point value, so that
+   * following searches play the same moves again
+   * @param seed random seed
+   */
+  void SetRandomSeed(unsigned seed);
 
  private:
   /**
-   * initialize board state to score table.
-   * convert each board state to binary mask number and lable its type.
+   * remaining children of a split point, shared by its tasks. Each task
+   * searches on its own copy of the position and takes the next sibling
+   * until none is left, so a split point copies the position once per
+   * task instead of once per sibling.
+   */
+  struct SplitWork {
+    SplitPoint* split;
+    const SearchPosition* position;   // position of the split node
+    const CandidateList* candidates;  // candidates of the split node
+    std::atomic<int> next;            // index of next sibling to search
+    int depth;
+    Stone player;
+    bool threatened;  // the opponent has an open three or better
+    // killers of the node and of the tasks, guarded by the split lock
+    int killers[MAX_SEARCH_PLY][KILLER_NUM];
+  };
+  /**
+   * positions copied by the split point tasks running on one thread.
+   * A thread waiting for a split point helps with other tasks, so the
+   * tasks on a thread nest like a stack. Positions are allocated when
+   * the stack first grows that deep and reused by every later split.
+   */
+  struct SplitStack {
+    std::vector<std::unique_ptr<SearchPosition>> positions;
+    size_t size = 0;  // number of positions used by running tasks
+  };
+  /**
+   * find best position to move, shared by AlphaBetaGo, AlphaBetaGoMT and
+   * pondering. The stop flag is reset by the caller
+   * @param board board status
+   * @param player current player
+   * @param x row index reference. Will be updated to best row index
+   * @param y column index reference. Will be updated to best column index
+   * @param multi_thread whether to use worker threads
+   * @return 1 for normal situation and 0 for no move available
+   */
+  int Search(Stone board[N][N], Stone player, int& x, int& y,
+             bool multi_thread);
+  /**
+   * keep the pondering search if it searches the given position, and
+   * start its deadline. Otherwise stop any background search and wait for
+   * it to return
+   * @param board board status
+   * @param player current player
+   * @return whether pondering searched the position
+   */
+  bool ContinuePondering(Stone board[N][N], Stone player);
+  /**
+   * reset stop flag, deadline and progress. Called before the search
+   * thread starts, so that a search stopped right away stays stopped
+   */
+  void BeginSearch();
+  /**
+   * run Search on a background thread
+   * @param board board status, copied
+   * @param player current player
+   * @param multi_thread whether to use worker threads
+   */
+  void LaunchSearch(Stone board[N][N], Stone player, bool multi_thread);
+  /**
+   * stop the background search, if any, and wait for it to return
+   */
+  void StopSearch();
+  /**
+   * wait for the background search and take its move
+   * @param x row index reference. Will be updated to best row index
+   * @param y column index reference. Will be updated to best column index
+   * @return 1 for normal situation and 0 for no move available or no
+   *         search started
+   */
+  int TakeBackgroundResult(int& x, int& y);
+  /**
+   * publish the result of a finished iteration of the main searcher
+   * @param depth depth of the iteration
+   * @param value best score
+   * @param x best row index
+   * @param y best column index
+   */
+  void ReportProgress(int depth, int value, int x, int y);
+  /**
+   * initialize score of each pattern type and the distinct point values.
+   * The score of each line address is generated at compile time, see
+   * PATTERN_TABLE
    */
   void InitScoreTable();
   /**
@@ -129,16 +621,289 @@ class AlphaBetaAlgorithm {
    * the search depth will significantly increase win rate but also
    * increase calculation in factorial manner.
    *
-   * @param board board status
+   * written in negamax form: the score is relative to the player to move,
+   * and a child score is negated for its parent. Children after the first
+   * are searched with principal variation search, see SearchChild.
+   *
+   * @param position searched position, restored before return
    * @param depth search depth (default is 3)
-   * @param maxPlayer max player
    * @param player current player
    * @param alpha alpha value
    * @param beta beta value
-   * @return the score
+   * @param split innermost split point above the node, nullptr for none
+   * @return the score for current player
    */
-  int MinMax(Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE], int depth,
-             Stone maxPlayer, Stone player, int alpha, int beta);
+  int MinMax(SearchPosition& position, int depth, Stone player, int alpha,
+             int beta, SplitPoint* split);
+  /**
+   * search a child whose move is already made. A child expected to fail
+   * low is only probed with a null window (alpha, alpha + 1), and searched
+   * again with the full window if it turns out better than alpha. A
+   * reduced child is probed at reduced depth first.
+   * @param position position of the child
+   * @param depth search depth of the child
+   * @param player player to move at the child
+   * @param alpha alpha value of the parent
+   * @param beta beta value of the parent
+   * @param full_window whether to search with the full window directly,
+   *        true for the first child
+   * @param reduction depth taken off the first null window probe
+   * @param split innermost split point above the child, nullptr for none
+   * @return the score for the parent player
+   */
+  int SearchChild(SearchPosition& position, int depth, Stone player,
+                  int alpha, int beta, bool full_window, int reduction,
+                  SplitPoint* split);
+  /**
+   * search only forcing moves below a leaf, so that a pending four or open
+   * three is played out before the position is evaluated. The player to
+   * move blocks a four of the opponent, answers an open three by blocking
+   * it or making a four, and otherwise may stand on the static score or
+   * make a four.
+   * @param position leaf position, restored before return
+   * @param player player to move
+   * @param alpha alpha value
+   * @param beta beta value
+   * @param depth remaining plies of forcing moves
+   * @param budget nodes left below the leaf, counted down by the node
+   * @param split innermost split point above the node, nullptr for none
+   * @return the score for current player
+   */
+  int Quiescence(SearchPosition& position, Stone player, int alpha, int beta,
+                 int depth, int& budget, SplitPoint* split);
+  /**
+   * get the depth taken off a candidate by late move reduction
+   * @param candidate candidate position
+   * @param index index of the candidate in the sorted list
+   * @param depth search depth of the node
+   * @param threatened whether the opponent has an open three or better
+   * @return depth reduction, 0 for none
+   */
+  int GetReduction(const CandidatePosition& candidate, int index, int depth,
+                   bool threatened) const;
+  /**
+   * check whether a player has an open three or better on the board,
+   * that the opponent has to answer right away
+   * @param cache score cache of the player
+   * @return whether any line has an open three or better
+   */
+  static bool HasThreat(const ScoreCache* cache);
+  /**
+   * search the remaining children of a node on worker threads, once its
+   * first child is searched. Window and best move of the node are updated
+   * with the result of all siblings, and killer moves found by the
+   * workers are merged into the position.
+   * @param position position of the node, only its killers are changed
+   * @param depth search depth of the node
+   * @param player current player
+   * @param alpha alpha value reference
+   * @param beta beta value reference
+   * @param parent innermost split point above the node, nullptr for none
+   * @param candidates candidate positions of the node
+   * @param first index of first candidate position not searched yet
+   * @param threatened whether the opponent has an open three or better
+   * @param bestValue best value reference
+   * @param bestX best row index reference
+   * @param bestY best column index reference
+   */
+  void SearchSplitPoint(SearchPosition& position, int depth, Stone player,
+                        int& alpha, int& beta, SplitPoint* parent,
+                        const CandidateList& candidates, int first,
+                        bool threatened, int& bestValue, int& bestX,
+                        int& bestY);
+  /**
+   * task of a split point. Copies the position once into a slot of the
+   * split stack of the calling thread, then takes siblings one by one
+   * until none is left or the split point is cut off
+   * @param work siblings shared by the tasks of the split point
+   */
+  void SearchSplitSiblings(SplitWork& work);
+  /**
+   * @return split stack of the calling thread
+   */
+  static SplitStack& GetSplitStack();
+  /**
+   * add killer moves of a search to the ones of another search of the
+   * same position. Moves already known are kept where they are
+   * @param from killer moves to add
+   * @param to killer moves reference
+   * @param first_ply first ply to merge, shallower plies are the same
+   */
+  static void MergeKillers(const int from[MAX_SEARCH_PLY][KILLER_NUM],
+                           int to[MAX_SEARCH_PLY][KILLER_NUM], int first_ply);
+  /**
+   * check whether the search of a node is no longer needed
+   * @param split innermost split point above the node, nullptr for none
+   * @return whether budget runs out or an enclosing split point is cut off
+   */
+  bool IsSearchCancelled(const SplitPoint* split) const;
+  /**
+   * move the candidate position with given coordinate to the head of
+   * the list, the rest keep their order. used to search transposition
+   * table best move first.
+   * @param candidates candidate positions
+   * @param x row index
+   * @param y column index
+   */
+  static void MoveToFront(CandidateList& candidates, int x, int y);
+  /**
+   * collect every empty grid within search range as root move,
+   * sorted by point value from highest to lowest. Moves of equal point
+   * value are shuffled, so that equal moves are played with variety.
+   * Safe to call from several threads, each with its own generator.
+   * @param position root position
+   * @param player current player
+   * @param random random generator of the calling thread
+   * @return root moves
+   */
+  std::vector<RootMove> GenerateRootMoves(SearchPosition& position,
+                                          Stone player, std::mt19937& random);
+  /**
+   * pick the best root move of a finished iteration, the first one of
+   * equal score. Moves failing low are only scored with an upper bound,
+   * so a later move of equal score may be worse. Root moves are then
+   * sorted by score so that next iteration searches the best move first.
+   * @param moves root moves of finished iteration
+   * @param x row index reference. Will be updated to best row index
+   * @param y column index reference. Will be updated to best column index
+   * @return best score
+   */
+  static int FinishIteration(std::vector<RootMove>& moves, int& x, int& y);
+  /**
+   * reset root position to given board, and score every line of it
+   * @param board board status
+   */
+  void InitRootPosition(Stone board[N][N]);
+  /**
+   * find root move that makes five in a row for the player
+   * @param position root position
+   * @param player current player
+   * @param moves root moves
+   * @param x row index reference. Updated to winning row index if found
+   * @param y column index reference. Updated to winning column index if found
+   * @return whether a winning move is found
+   */
+  bool FindWinningMove(SearchPosition& position, Stone player,
+                       const std::vector<RootMove>& moves, int& x, int& y);
+  /**
+   * find root move forced by threats: block the five of the opponent, or
+   * start a victory by continuous fours or continuous threats found by
+   * threat solver
+   * @param position root position
+   * @param player current player
+   * @param x row index reference. Updated to forced row index if found
+   * @param y column index reference. Updated to forced column index if found
+   * @return whether a forced move is found
+   */
+  bool FindForcedMove(SearchPosition& position, Stone player, int& x, int& y);
+  /**
+   * place a stone, update hash, winner and score of the four lines through it
+   * @param position position reference
+   * @param x row index
+   * @param y column index
+   * @param player stone to place
+   * @param undo undo reference, filled with line scores before the move
+   */
+  void MakeMove(SearchPosition& position, int x, int y, Stone player,
+                MoveUndo& undo);
+  /**
+   * remove the stone placed by MakeMove and restore hash and line scores
+   * @param position position reference
+   * @param x row index
+   * @param y column index
+   * @param undo undo filled by MakeMove
+   */
+  static void UnmakeMove(SearchPosition& position, int x, int y,
+                         const MoveUndo& undo);
+  /**
+   * get index of the four lines through a point in ScoreCache arrays
+   * @param x row index
+   * @param y column index
+   * @param index index reference of row, column, diagonal, anti-diagonal
+   */
+  static void GetLineIndex(int x, int y, int index[4]);
+  /**
+   * iterative deepening search of root moves on a single thread
+   * @param position root position
+   * @param player current player
+   * @param moves root moves, sorted by score after each iteration
+   * @param start_depth depth of the first iteration
+   * @param first_move index of root move searched first in each iteration
+   * @param x row index reference. Will be updated to best row index
+   * @param y column index reference. Will be updated to best column index
+   * @param value best score reference of the last finished iteration
+   * @param report_progress whether to publish finished iterations, false
+   *        for helper threads
+   * @return depth of the last finished iteration, 0 if none finishes
+   */
+  int SearchIterative(SearchPosition& position, Stone player,
+                      std::vector<RootMove>& moves, int start_depth,
+                      size_t first_move, int& x, int& y, int& value,
+                      bool report_progress);
+  /**
+   * search every root move once with principal variation search. The
+   * first move gets the full window, the rest a null window unless they
+   * beat the best score so far
+   * @param position root position
+   * @param player current player
+   * @param moves root moves, value of each searched move is updated
+   * @param depth search depth below root moves
+   * @param first_move index of root move searched first
+   * @param alpha alpha value
+   * @param beta beta value, the search stops once a move reaches it
+   * @return best score, only a bound if outside the window
+   */
+  int SearchRootMoves(SearchPosition& position, Stone player,
+                      std::vector<RootMove>& moves, int depth,
+                      size_t first_move, int alpha, int beta);
+  /**
+   * iterative deepening where each root move is a separate worker task
+   * @param position root position
+   * @param player current player
+   * @param moves root moves
+   * @param x row index reference. Will be updated to best row index
+   * @param y column index reference. Will be updated to best column index
+   */
+  void SearchRootSplit(const SearchPosition& position, Stone player,
+                       std::vector<RootMove>& moves, int& x, int& y);
+  /**
+   * lazy SMP search. Calling thread runs iterative deepening while every
+   * worker runs its own copy at staggered depth, sharing transposition
+   * table. Result of the calling thread is returned.
+   * @param position root position
+   * @param player current player
+   * @param moves root moves
+   * @param x row index reference. Will be updated to best row index
+   * @param y column index reference. Will be updated to best column index
+   */
+  void SearchLazySMP(SearchPosition& position, Stone player,
+                     const std::vector<RootMove>& moves, int& x, int& y);
+  /**
+   * remember a move causing a cutoff. It becomes a killer move of its
+   * ply, and its history score grows with the depth searched below it
+   * @param position position the move is searched on
+   * @param player player making the move
+   * @param x row index
+   * @param y column index
+   * @param depth remaining depth of the node
+   */
+  void RecordCutoff(SearchPosition& position, Stone player, int x, int y,
+                    int depth);
+  /**
+   * halve every history score, so that cutoffs of previous searches
+   * count less than the ones of current search
+   */
+  void AgeHistory();
+  /**
+   * reset node counter and statistics. Stop flag and deadline are set by
+   * BeginSearch
+   */
+  void ResetStatistics();
+  /**
+   * count one searched node and check the search budget
+   * @return whether search should be stopped
+   */
+  bool IsSearchStopped();
   /**
    * calculate the numeric value of the board
    *
@@ -146,71 +911,82 @@ class AlphaBetaAlgorithm {
    * the main idea is to create a hash table for the board and store
    * value in ScoreCache strcture.
    *
-   * All its helper functions have run time below O(n^2) with some
-   * helper functions have run time about O(nlogn).
+   * score caches of the position are kept up to date by every move,
+   * so evaluation only reads line counts of each pattern type.
    *
-   * @param board board status
-   * @param maxPlayer maximum player (the auto player)
+   * @param position position to evaluate
+   * @param player player the score is relative to
    * @return numerically valuation of the board
    */
-  int EvaluateMinMax(Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE],
-                     Stone maxPlayer);
+  int EvaluateMinMax(SearchPosition& position, Stone player);
   /**
-   * check if the position is valid. A valid position means there's at least
-   * one occupied grid within the range of target grid.
-   *
-   * the range variable is defined Minimax header file. Change its value will
-   * result in slightly higher win rate with much lower efficiency.
-   *
-   * @param board board status
-   * @param x x coordinate
-   * @param y y coordinate
-   * @return whether the position is valid.
+   * check whether the player to move at a leaf wins by a short sequence
+   * of continuous threats. Only probed when the player has a three or a
+   * four on the board
+   * @param position leaf position
+   * @param player player to move
+   * @return THREAT_WIN_SCORE if the win is read out, otherwise a bonus
+   * for an open three the opponent can not answer with a four
    */
-  static bool IsValidPosition(Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE],
-                              int x, int y);
+  int ProbeLeafThreats(SearchPosition& position, Stone player);
   /**
    * perform search for candidate positions for given player.
-   * use doubly linked list to sort them by point value
-   * this functions is to increase pruning efficiency
+   * sort them by point value, this functions is to increase pruning
+   * efficiency
+   *
+   * candidates are the empty grids within search range of a stone,
+   * kept up to date by every move made on the position. Point values
+   * come from a few pattern scores, so they are ordered by bucket sort.
+   * Grids of the same value are ordered by killer moves of the ply
+   * first, then by history score.
    *
-   * @param chess board state
+   * @param position position to search
    * @param player current player
-   * @return the root of doubly linked list
+   * @param candidates candidate list reference, filled with sorted positions
+   */
+  void SearchCandidatePosition(SearchPosition& position, Stone player,
+                               CandidateList& candidates);
+  /**
+   * get the bucket of a point value, buckets are ordered from highest
+   * to lowest score
+   * @param value point value
+   * @return bucket index
    */
-  CandidatePosition* SearchCandidatePosition(
-      Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE], Stone player);
+  int GetScoreBucket(int value) const;
   /**
    * score the whole chess baord and store score for each point in each
-   * direction in ScoreCache structure
+   * direction in ScoreCache structure, and count lines of each type
    *
    * this function is used to store the board the passed to alpha-beta-go
    * since we don't need to perform duplicate calculation in later simulation
    *
+   * both players are scored in one pass of LineScorer
+   *
    * @param board board status
-   * @param player target player
-   * @param pCache SchoreCache instance
+   * @param pBlackCache SchoreCache instance of black
+   * @param pWhiteCache SchoreCache instance of white
    */
-  void ScoreChessToCache(Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE],
-                         Stone player, ScoreCache* pCache);
+  void ScoreChessToCache(Stone board[N][N], ScoreCache* pBlackCache,
+                         ScoreCache* pWhiteCache);
   /**
    * calculate point value at given position and store it ScoreCache structure
-   * helper function for evaluate minimax
+   * helper function for evaluate minimax. rescans the four lines through
+   * the point for both players and updates line count of each type
    *
    * @param board board status
-   * @param player player type
    * @param x target x
    * @param y target y
-   * @param pCache pCache pointer
+   * @param pBlackCache ScoreCache pointer of black
+   * @param pWhiteCache ScoreCache pointer of white
    */
-  void ScoreChessPointToCache(Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE],
-                              Stone player, int x, int y, ScoreCache* pCache);
+  void ScoreChessPointToCache(Stone board[N][N], int x, int y,
+                              ScoreCache* pBlackCache, ScoreCache* pWhiteCache);
   /**
    * retrieve final score for the board based on ScoreCache table
    * @param pCache ScoreCache pointer
    * @return final score for the board
    */
-  static int ScoreChess(ScoreCache* pCache);
+  int ScoreChess(const ScoreCache* pCache) const;
   /**
    * get the score of the certain direction containing certain point
    *
@@ -226,8 +1002,8 @@ class AlphaBetaAlgorithm {
    * @param type best type reference
    * @return best score in this direction containing this point.
    */
-  int ScorePointDir(Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE],
-                    Stone player, int dir, int x, int y, int& type);
+  int ScorePointDir(Stone board[N][N], Stone player, int dir, int x, int y,
+                    int& type);
   /**
    * get the score of target point.
    * this function is used to perform candidate position sort
@@ -239,89 +1015,130 @@ class AlphaBetaAlgorithm {
    * @param y target y coordinate
    * @return the score of the point
    */
-  int ScorePoint(Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE], Stone player,
-                 int x, int y);
+  int ScorePoint(Stone board[N][N], Stone player, int x, int y);
   /**
-   * get winner of the board
+   * get winner of the board by scanning every stone. Search only uses it
+   * for the root, positions below track the winner move by move
    * @param board board status
    * @return winner stone type (empty for draw case)
    */
-  static int GetWinner(Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE]);
-  /**
-   * find mask in address snippet
-   * @param addr address that need to be checked
-   * @param addrBitCount address bit count
-   * @param mask target mask
-   * @param maskBitCount mask bit count
-   * @return whether address contains mask snippet
-   */
-  static bool IsAddrContainsMask(int addr, int addrBitCount, int mask,
-                                 int maskBitCount);
+  static int GetWinner(Stone board[N][N]);
 
  private:
-  // store score of every combination of 7 consecutive stones
-  int score_table[BIT_DATA_SIZE];
-  // store pattern type of every combination of 7 consecutive stones
-  int score_type_table[BIT_DATA_SIZE];
-  // backup board used for simulation
-  int board_backup[Game::BOARD_SIZE][Game::BOARD_SIZE];
-  // black side score cache
-  ScoreCache black_score_cache;
-  // white side score cache
-  ScoreCache white_score_cache;
-  // hard-coding pattern (seems like this can only be hard coding)
-  Pattern pattern[28] = {{"11111", 1000000, CONSECUTIVE_FIVE},
-                         {"011110", 11000, OPEN_FOUR},
-                         {"0011112", 220, MAKE_CONSECUTIVE_FOUR},
-                         {"0101112", 220, MAKE_CONSECUTIVE_FOUR},
-                         {"0110112", 220, MAKE_CONSECUTIVE_FOUR},
-                         {"0111012", 220, MAKE_CONSECUTIVE_FOUR},
-                         {"0110110", 220, MAKE_CONSECUTIVE_FOUR},
-                         {"0101110", 220, MAKE_CONSECUTIVE_FOUR},
-                         {"001110", 210, OPEN_THREE},
-                         {"010110", 210, OPEN_THREE},
-                         {"001112", 60, HALF_OPEN_THREE},
-                         {"010112", 60, HALF_OPEN_THREE},
-                         {"011012", 60, HALF_OPEN_THREE},
-                         {"10011", 60, HALF_OPEN_THREE},
-                         {"10101", 60, HALF_OPEN_THREE},
-                         {"2011102", 60, HALF_OPEN_THREE},
-                         {"00110", 15, OPEN_TWO},
-                         {"01010", 15, OPEN_TWO},
-                         {"010010", 15, OPEN_TWO},
-                         {"000112", 13, HALF_OPEN_TWO},
-                         {"001012", 13, HALF_OPEN_TWO},
-                         {"010012", 13, HALF_OPEN_TWO},
-                         {"10001", 13, HALF_OPEN_TWO},
-                         {"2010102", 13, HALF_OPEN_TWO},
-                         {"2011002", 13, HALF_OPEN_TWO},
-                         {"211112", 0, CLOSE_FOUR},
-                         {"21112", 0, CLOSE_THREE},
-                         {"2112", 0, CLOSE_TWO}};
+  // score of each scored pattern type
+  int type_score[HALF_OPEN_TWO + 1];
+  // every distinct point value from highest to lowest
+  int score_levels[SCORE_BUCKET_NUM];
+  int score_level_num;
+  // board passed to the latest search and score of its lines
+  SearchPosition root_position;
+  // searched positions shared by all search threads
+  TranspositionTable transposition_table;
+  // moves of opening positions, probed before the full search
+  OpeningBook opening_book;
+  // forced wins searched before the full search
+  ThreatSolver threat_solver;
+  // budget of victory by continuous threats at the root
+  ThreatLimits threat_limits;
+  // whether leaves are probed for victory by continuous threats
+  bool threat_probe;
+  // whether candidates of equal value are ordered by killers and history
+  bool move_ordering;
+  // whether late moves and iterations are searched with narrow windows
+  bool principal_variation;
+  // late move reduction and futility pruning settings
+  PruningOptions pruning;
+  // depth, time and node budget of each search
+  SearchLimits limits;
+  // set when the search budget runs out
+  std::atomic<bool> stop_search;
+  // number of nodes searched by all threads
+  std::atomic<long long> node_count;
+  // statistics of the latest finished search
+  int completed_depth;
+  int best_value;
+  bool winning_move;
+  bool forced_move;
+  long long threat_nodes;
+  bool book_move;
+  bool ponder_hit;
+  std::atomic<long long> reduced_moves;
+  std::atomic<long long> reduction_failures;
+  std::atomic<long long> futility_prunes;
+  std::atomic<long long> quiescence_nodes;
+  // how AlphaBetaGoMT uses worker threads
+  ParallelMode parallel_mode;
+  // threads of the worker pool, 0 for one per hardware thread
+  int thread_num;
+  // shuffles root moves of the main searcher, and seeds the generators of
+  // Lazy SMP helpers
+  std::mt19937 root_random;
+  // whether MinMax shares children with workers, set during SPLIT_POINT
+  // search only
+  bool split_search;
+  // search running on a background thread, started by AlphaBetaGoAsync
+  // or StartPondering
+  std::future<int> background_search;
+  // number of the background search, and of the latest search started
+  long long background_id;
+  long long search_count;
+  // board, player and best move of the background search. The move is
+  // read once the search returns
+  Stone background_board[N][N];
+  Stone background_player;
+  int background_x;
+  int background_y;
+  // whether the background search is pondering, and the predicted reply
+  bool pondering;
+  int ponder_x;
+  int ponder_y;
+  // steady clock time the search stops at, 0 for none
+  std::atomic<std::chrono::steady_clock::rep> search_deadline;
+  // result of the last finished iteration of the running search
+  std::atomic<int> progress_depth;
+  std::atomic<int> progress_value;
+  std::atomic<int> progress_move;  // x * N + y, -1 if none
+  // cutoffs caused by each grid, index by color (black, white) and grid.
+  // shared by all search threads
+  std::atomic<int> history[2][N][N];
 
   /**
    * execute minimax algorithm to find numeric value of the point.
    * retrieve board and point info from program
    *
-   * @param pParam program pointer
-   * @return unassigned int representing status
+   * @param program program pointer
+   */
+  static void MinMaxThread(MinMaxThreadParam* program);
+  /**
+   * get the worker pool, create it on first use
+   * @return worker pool shared by all parallel searches of this instance
    */
-  static DWORD WINAPI MinMaxThread(void* pParam);
+  ThreadPool& GetThreadPool();
+
+ private:
+  // persistent worker threads, created on first parallel search
+  std::unique_ptr<ThreadPool> thread_pool;
 };
 /**
  * struct used to pass all arguments to multiple thread program.
- * Since it only accepts one argument, we wrap it up in a
- * single struct.
+ * Each root move task owns one, so that every task searches on its
+ * own copy of the position.
  */
-struct MinMaxThreadParam {
-  AlphaBetaAlgorithm* pAlgorithm;
-  Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE];
+template <int N, int K>
+struct BasicMinMaxThreadParam {
+  BasicAlphaBetaAlgorithm<N, K>* pAlgorithm;
+  BasicSearchPosition<N, K> position;
   int x;
   int y;
+  int index;
   int depth;
   Stone maxPlayer;
   Stone player;
   int bestValue;
 };
 
+// engine of the standard board, played by the app
+using AlphaBetaAlgorithm =
+    BasicAlphaBetaAlgorithm<Game::BOARD_SIZE, Game::WINNING_THRESHOLD>;
+
 #endif  // FINALPROJECT_MINIMAX_H
@@ -0,0 +1,151 @@
+//
+// Opening book mapped from disk.
+//
+
+#ifndef FINALPROJECT_OPENINGBOOK_H
+#define FINALPROJECT_OPENINGBOOK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Game.h"
+#include "Zobrist.h"
+
+// first bytes of every book file
+static const char BOOK_MAGIC[8] = {'G', 'M', 'K', 'B', 'O', 'O', 'K', '\0'};
+// book file format version, bumped when header or entry layout changes
+static const uint32_t BOOK_VERSION = 2;
+
+/**
+ * header at the start of a book file, followed by the entries
+ */
+struct BookHeader {
+  char magic[8];       // BOOK_MAGIC
+  uint32_t version;    // BOOK_VERSION
+  uint32_t entry_num;  // number of entries following the header
+  // board of the positions. Hashes of every board size share the same
+  // random keys, so a book only matches the board it is built for
+  uint32_t board_size;  // N, number of rows and columns
+  uint32_t win_length;  // K, number of stones in a row to win
+};
+/**
+ * book move of one position (16 bytes). The move is stored in the
+ * orientation of the canonical board, see Zobrist::CanonicalHash
+ */
+struct BookEntry {
+  uint64_t key;          // canonical hash of the position and player to move
+  int32_t value;         // search score of the move for the player to move
+  uint8_t row_index;     // move row index on the canonical board
+  uint8_t column_index;  // move column index on the canonical board
+  uint16_t depth;        // search depth the move is found with
+};
+
+/**
+ * read-only book of opening moves, keyed by the canonical hash of the
+ * board so that the eight symmetric images of a position share an entry.
+ *
+ * the file is an array of entries sorted by key after a small header. It
+ * is memory-mapped instead of read, so opening a book costs nothing until
+ * entries are probed, and every process playing from the same book shares
+ * its pages. Probing is a binary search over the mapped entries. Files are
+ * written in the byte order of the machine, little-endian on every
+ * supported platform.
+ */
+class OpeningBook {
+ public:
+  /**
+   * create book without any entry
+   */
+  OpeningBook() = default;
+  /**
+   * unmap the book file
+   */
+  ~OpeningBook();
+  OpeningBook(const OpeningBook&) = delete;
+  OpeningBook& operator=(const OpeningBook&) = delete;
+  /**
+   * map a book file, the previous one is closed
+   * @param path book file path
+   * @param board_size board size the book has to be built for
+   * @param win_length number of stones in a row to win of the book
+   * @return whether the file exists and is a valid book of the board
+   */
+  bool Open(const std::string& path, int board_size, int win_length);
+  /**
+   * unmap the book file, following probes find nothing
+   */
+  void Close();
+  /**
+   * @return number of positions in the book
+   */
+  size_t GetSize() const { return entry_num; }
+  /**
+   * @return entries sorted by key, GetSize() of them
+   */
+  const BookEntry* GetEntries() const { return entries; }
+  /**
+   * find the book move of a position. Instantiated for every board size
+   * of FOR_EACH_BOARD_VARIANT, a book only holds positions of one size
+   * and finds nothing on other boards
+   * @param board board status
+   * @param player player to move
+   * @param x row index reference. Updated to book move if found
+   * @param y column index reference. Updated to book move if found
+   * @return whether the position is in the book and its move is empty
+   */
+  template <int N>
+  bool Probe(Stone board[N][N], Stone player, int& x, int& y) const;
+  /**
+   * find the book move of a position whose symmetric hashes are already
+   * maintained, so the board is not hashed again
+   * @param hash hashes of the board and its symmetric images
+   * @param board board status
+   * @param player player to move
+   * @param x row index reference. Updated to book move if found
+   * @param y column index reference. Updated to book move if found
+   * @return whether the position is in the book and its move is empty
+   */
+  template <int N>
+  bool Probe(const BasicSymmetricHash<N>& hash, Stone board[N][N],
+             Stone player, int& x, int& y) const;
+  /**
+   * get the key of a position
+   * @param board board status
+   * @param player player to move
+   * @param symmetry symmetry reference, updated to the one mapping the
+   *        board to its canonical image
+   * @return book key
+   */
+  template <int N>
+  static uint64_t GetKey(Stone board[N][N], Stone player, int& symmetry);
+  /**
+   * write a book file
+   * @param path book file path
+   * @param book_entries entries with distinct keys, in any order
+   * @param board_size board size of the positions
+   * @param win_length number of stones in a row to win
+   * @return whether the file is written
+   */
+  static bool Write(const std::string& path,
+                    std::vector<BookEntry> book_entries, int board_size,
+                    int win_length);
+
+ private:
+  // mapped file, nullptr if no book is open
+  void* mapping = nullptr;
+  size_t mapping_size = 0;
+  // entries inside the mapping
+  const BookEntry* entries = nullptr;
+  size_t entry_num = 0;
+  // board size of the open book, 0 if no book is open
+  int board_size = 0;
+#ifdef _WIN32
+  // file and file mapping handles
+  void* file_handle = nullptr;
+  void* map_handle = nullptr;
+#endif
+};
+
+#endif  // FINALPROJECT_OPENINGBOOK_H
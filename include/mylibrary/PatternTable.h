@@ -0,0 +1,182 @@
+//
+// Score and type of every line pattern, generated at compile time.
+//
+
+#ifndef FINALPROJECT_PATTERNTABLE_H
+#define FINALPROJECT_PATTERNTABLE_H
+
+#include <cstdint>
+
+// we only care about 7 consecutive stones on the board
+// each stone convert to 2 bit number, 00 , 01, or 11
+// therefore, max size would be 2^(7 * 2) = 0x3fff
+static const int BIT_DATA_LENGTH = 14;
+static const int BIT_DATA_SIZE = 0x3fff;  // NOLINT
+// number of hard-coded patterns
+static const int PATTERN_NUM = 28;
+// low bits of a pattern table entry holding the pattern type, the high
+// bits hold the score
+static const int PATTERN_TYPE_BITS = 4;
+
+/**
+ * all gomoku stone patterns that can contribute to winning.
+ */
+enum PatternType {
+  NONE,
+  CONSECUTIVE_FIVE,
+  OPEN_FOUR,
+  MAKE_CONSECUTIVE_FOUR,
+  OPEN_THREE,
+  HALF_OPEN_THREE,
+  OPEN_TWO,
+  HALF_OPEN_TWO,
+  CLOSE_FOUR,
+  CLOSE_THREE,
+  CLOSE_TWO
+};
+/**
+ * pattern struct used to store char pattern
+ * and corresponding score and type enum.
+ */
+struct Pattern {
+  char string_pattern[BIT_DATA_LENGTH / 2 + 1];
+  int score;
+  int type;
+};
+
+// hard-coding pattern (seems like this can only be hard coding).
+// '1' is a stone of the player, '2' a stone of the opponent or the edge
+static constexpr Pattern PATTERNS[PATTERN_NUM] = {
+    {"11111", 1000000, CONSECUTIVE_FIVE},
+    {"011110", 11000, OPEN_FOUR},
+    {"0011112", 220, MAKE_CONSECUTIVE_FOUR},
+    {"0101112", 220, MAKE_CONSECUTIVE_FOUR},
+    {"0110112", 220, MAKE_CONSECUTIVE_FOUR},
+    {"0111012", 220, MAKE_CONSECUTIVE_FOUR},
+    {"0110110", 220, MAKE_CONSECUTIVE_FOUR},
+    {"0101110", 220, MAKE_CONSECUTIVE_FOUR},
+    {"001110", 210, OPEN_THREE},
+    {"010110", 210, OPEN_THREE},
+    {"001112", 60, HALF_OPEN_THREE},
+    {"010112", 60, HALF_OPEN_THREE},
+    {"011012", 60, HALF_OPEN_THREE},
+    {"10011", 60, HALF_OPEN_THREE},
+    {"10101", 60, HALF_OPEN_THREE},
+    {"2011102", 60, HALF_OPEN_THREE},
+    {"00110", 15, OPEN_TWO},
+    {"01010", 15, OPEN_TWO},
+    {"010010", 15, OPEN_TWO},
+    {"000112", 13, HALF_OPEN_TWO},
+    {"001012", 13, HALF_OPEN_TWO},
+    {"010012", 13, HALF_OPEN_TWO},
+    {"10001", 13, HALF_OPEN_TWO},
+    {"2010102", 13, HALF_OPEN_TWO},
+    {"2011002", 13, HALF_OPEN_TWO},
+    {"211112", 0, CLOSE_FOUR},
+    {"21112", 0, CLOSE_THREE},
+    {"2112", 0, CLOSE_TWO}};
+
+/**
+ * score and pattern type of every combination of 7 consecutive stones,
+ * index by line address. Both are packed into one 32 bit entry, so that
+ * scoring a line window reads a single word, and the whole table takes
+ * 64 KB shared by every engine and thread.
+ */
+struct PatternTable {
+  uint32_t entry[BIT_DATA_SIZE];
+};
+
+/**
+ * pack a pattern score and type into a table entry
+ * @param score pattern score, not negative
+ * @param type pattern type
+ * @return table entry
+ */
+constexpr uint32_t PackPattern(int score, int type) {
+  return (static_cast<uint32_t>(score) << PATTERN_TYPE_BITS) |  // NOLINT
+         static_cast<uint32_t>(type);
+}
+/**
+ * @param entry table entry
+ * @return pattern score of the entry
+ */
+constexpr int GetPatternScore(uint32_t entry) {
+  return static_cast<int>(entry >> PATTERN_TYPE_BITS);  // NOLINT
+}
+/**
+ * @param entry table entry
+ * @return pattern type of the entry
+ */
+constexpr int GetPatternType(uint32_t entry) {
+  return static_cast<int>(entry & ((1U << PATTERN_TYPE_BITS) - 1U));  // NOLINT
+}
+
+/**
+ * get the number of grids of a pattern
+ * @param pattern pattern
+ * @return pattern length
+ */
+constexpr int PatternLength(const Pattern& pattern) {
+  int length = 0;
+  while (pattern.string_pattern[length] != '\0') length++;
+  return length;
+}
+
+/**
+ * convert a pattern to its address bits, first grid in the highest bits
+ * @param pattern pattern
+ * @param reverse whether to read the pattern backward
+ * @return pattern mask
+ */
+constexpr int PatternMask(const Pattern& pattern, bool reverse) {
+  int length = PatternLength(pattern);
+  int mask = 0;
+  for (int j = 0; j < length; j++) {
+    char grid = pattern.string_pattern[reverse ? length - j - 1 : j];
+    mask <<= 2;  // NOLINT
+    if (grid == '1') mask |= 1;  // NOLINT
+    if (grid == '2') mask |= 2;  // NOLINT
+  }
+  return mask;
+}
+
+/**
+ * build the pattern table. An address gets the first pattern it contains,
+ * read forward or backward, except that a pattern of zero score may be
+ * replaced by a later one.
+ *
+ * instead of checking every address against every pattern, the addresses
+ * containing a pattern are enumerated by filling the grids around it, so
+ * that the table is cheap enough to evaluate at compile time.
+ * @return pattern table
+ */
+constexpr PatternTable MakePatternTable() {
+  PatternTable table{};
+  for (const Pattern& pattern : PATTERNS) {
+    int length = PatternLength(pattern);
+    for (int reverse = 0; reverse < 2; reverse++) {
+      int mask = PatternMask(pattern, reverse != 0);
+      // grids below and above the pattern take every value
+      for (int low_grids = 0; low_grids + length <= BIT_DATA_LENGTH / 2;
+           low_grids++) {
+        int high_grids = BIT_DATA_LENGTH / 2 - length - low_grids;
+        for (int high = 0; high < 1 << (2 * high_grids); high++) {  // NOLINT
+          for (int low = 0; low < 1 << (2 * low_grids); low++) {  // NOLINT
+            int addr = (high << (2 * (low_grids + length))) |  // NOLINT
+                       (mask << (2 * low_grids)) | low;         // NOLINT
+            if (addr < BIT_DATA_SIZE &&
+                GetPatternScore(table.entry[addr]) == 0)
+              table.entry[addr] = PackPattern(pattern.score, pattern.type);
+          }
+        }
+      }
+    }
+  }
+  return table;
+}
+
+// pattern table shared by all engines, generated at compile time and
+// stored in read-only data
+extern const PatternTable PATTERN_TABLE;
+
+#endif  // FINALPROJECT_PATTERNTABLE_H
@@ -0,0 +1,98 @@
+//
+// Search engine of a board size chosen at run time.
+//
+
+#ifndef FINALPROJECT_SEARCHENGINE_H
+#define FINALPROJECT_SEARCHENGINE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "Game.h"
+#include "MiniMax.h"
+
+/**
+ * alpha-beta search of one board variant, selected at run time.
+ *
+ * every variant of FOR_EACH_BOARD_VARIANT has its own engine instantiated
+ * from BasicAlphaBetaAlgorithm, so the loops of its search are bounded by
+ * its board size at compile time. This interface hides the board size:
+ * boards are passed as board size x board size grids in row order, grid
+ * (x, y) at x * board size + y.
+ */
+class SearchEngine {
+ public:
+  virtual ~SearchEngine() = default;
+  /**
+   * @return number of rows and columns of the board
+   */
+  virtual int GetBoardSize() const = 0;
+  /**
+   * @return number of stones in a row to win
+   */
+  virtual int GetWinLength() const = 0;
+  /**
+   * find best position to move, see AlphaBetaAlgorithm::AlphaBetaGo
+   * @param board board status, in row order
+   * @param player current player
+   * @param x row index reference. Will be updated to best row index
+   * @param y column index reference. Will be updated to best column index
+   * @return 1 for normal situation and 0 for no move available
+   */
+  virtual int AlphaBetaGo(const Stone* board, Stone player, int& x,
+                          int& y) = 0;
+  /**
+   * find best position to move with worker threads, see
+   * AlphaBetaAlgorithm::AlphaBetaGoMT
+   * @param board board status, in row order
+   * @param player current player
+   * @param x row index reference. Will be updated to best row index
+   * @param y column index reference. Will be updated to best column index
+   * @return 1 for normal situation and 0 for no move available
+   */
+  virtual int AlphaBetaGoMT(const Stone* board, Stone player, int& x,
+                            int& y) = 0;
+  /**
+   * set depth, time and node budget of the following searches
+   * @param search_limits search budget
+   */
+  virtual void SetSearchLimits(const SearchLimits& search_limits) = 0;
+  /**
+   * @return search budget
+   */
+  virtual SearchLimits GetSearchLimits() const = 0;
+  /**
+   * @return statistics of the latest search
+   */
+  virtual SearchStatistics GetStatistics() const = 0;
+  /**
+   * set how AlphaBetaGoMT uses worker threads
+   * @param mode parallel search mode
+   */
+  virtual void SetParallelMode(ParallelMode mode) = 0;
+  /**
+   * resize the transposition table, clearing it
+   * @param table_size number of transposition table entries
+   */
+  virtual void SetTranspositionTableSize(size_t table_size) = 0;
+  /**
+   * open an opening book built for the same board size
+   * @param path path of the book file
+   * @return whether the book is opened
+   */
+  virtual bool LoadOpeningBook(const std::string& path) = 0;
+};
+
+/**
+ * create the engine of a board variant
+ * @param board_size number of rows and columns of the board
+ * @param win_length number of stones in a row to win
+ * @param table_size number of transposition table entries
+ * @return engine, nullptr if the variant is not instantiated
+ */
+std::unique_ptr<SearchEngine> CreateSearchEngine(
+    int board_size, int win_length,
+    size_t table_size = TRANSPOSITION_TABLE_SIZE);
+
+#endif  // FINALPROJECT_SEARCHENGINE_H
@@ -0,0 +1,18 @@
+//
+// Stone types and board variants shared by the game and the bitboard.
+//
+
+#ifndef FINALPROJECT_STONE_H
+#define FINALPROJECT_STONE_H
+
+enum Stone { EMPTY, BLACK, WHITE };
+
+// board size and win length of every variant the library is built for:
+// the standard 19x19 board, the 15x15 board of gomoku rules and a small
+// training board. Each source file instantiates its templates for them
+#define FOR_EACH_BOARD_VARIANT(VARIANT) \
+  VARIANT(19, 5)                       \
+  VARIANT(15, 5)                       \
+  VARIANT(9, 5)
+
+#endif  // FINALPROJECT_STONE_H
@@ -0,0 +1,129 @@
+//
+// Persistent work-stealing thread pool used by parallel search.
+//
+
+#ifndef FINALPROJECT_THREADPOOL_H
+#define FINALPROJECT_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * a group of tasks submitted together, used to wait for all of them.
+ */
+class TaskGroup {
+ public:
+  TaskGroup() : pending(0) {}
+  /**
+   * @return whether every task of the group has finished
+   */
+  bool IsDone() const { return pending.load() == 0; }
+
+ private:
+  friend class ThreadPool;
+  // number of unfinished tasks
+  std::atomic<int> pending;
+  // used to wake up thread waiting for the group
+  std::mutex lock;
+  std::condition_variable done;
+};
+/**
+ * fixed number of worker threads created once and reused by every search.
+ *
+ * each worker owns a task queue. A worker runs tasks from the front of its
+ * own queue, and steals from the back of other queues when its own queue is
+ * empty, so that a few long tasks do not leave the other workers idle.
+ */
+class ThreadPool {
+ public:
+  /**
+   * start worker threads
+   * @param thread_num number of workers, 0 to use hardware concurrency
+   */
+  explicit ThreadPool(int thread_num = 0);
+  /**
+   * finish queued tasks and join all worker threads
+   */
+  ~ThreadPool();
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  /**
+   * queue a task. Task submitted from a worker goes to the worker's own
+   * queue, otherwise queues are filled in round robin.
+   * @param group group the task belongs to
+   * @param task the task
+   */
+  void Submit(TaskGroup& group, std::function<void()> task);
+  /**
+   * wait until every task in the group finishes. The calling thread runs
+   * queued tasks while waiting, so it is safe to wait inside a task.
+   * @param group the task group
+   */
+  void Wait(TaskGroup& group);
+  /**
+   * @return number of worker threads
+   */
+  int GetThreadNum() const { return static_cast<int>(workers.size()); }
+
+ private:
+  /**
+   * task with the group it belongs to
+   */
+  struct Task {
+    std::function<void()> run;
+    TaskGroup* group;
+  };
+  /**
+   * task queue owned by one worker
+   */
+  struct WorkQueue {
+    std::mutex lock;
+    std::deque<Task> tasks;
+  };
+  /**
+   * main loop of worker thread
+   * @param index worker index
+   */
+  void WorkerLoop(int index);
+  /**
+   * run one queued task, own queue first, then steal from others
+   * @param index worker index, -1 for thread outside of the pool
+   * @return whether a task has been run
+   */
+  bool RunPendingTask(int index);
+  /**
+   * take a task from given queue
+   * @param queue queue index
+   * @param steal take from back of the queue instead of the front
+   * @param task task reference, filled if a task is taken
+   * @return whether a task is taken
+   */
+  bool PopTask(size_t queue, bool steal, Task& task);
+  /**
+   * @return index of current thread in this pool, -1 if not a worker
+   */
+  int CurrentWorker() const;
+
+ private:
+  // worker threads
+  std::vector<std::thread> workers;
+  // one queue per worker
+  std::vector<std::unique_ptr<WorkQueue>> queues;
+  // number of queued tasks of all queues
+  std::atomic<int> queued;
+  // next queue used by tasks submitted from outside
+  std::atomic<unsigned> next_queue;
+  // used to put idle workers to sleep
+  std::mutex sleep_lock;
+  std::condition_variable wake;
+  // set when the pool is being destroyed
+  bool stopping;
+};
+
+#endif  // FINALPROJECT_THREADPOOL_H
@@ -0,0 +1,257 @@
+//
+// Threat space search for forced wins.
+//
+
+#ifndef FINALPROJECT_THREATSOLVER_H
+#define FINALPROJECT_THREATSOLVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BitBoard.h"
+#include "Game.h"
+#include "Zobrist.h"
+
+// deepest victory by continuous fours, in attacker moves
+static const int VCF_MAX_DEPTH = 16;
+// searched node budget of one victory by continuous fours
+static const long long VCF_NODE_LIMIT = 10000;
+// deepest victory by continuous threats, in attacker moves
+static const int VCT_MAX_DEPTH = 8;
+// searched node budget of one victory by continuous threats
+static const long long VCT_NODE_LIMIT = 20000;
+// wall-clock budget of one victory by continuous threats
+static const int VCT_TIME_LIMIT_MS = 200;
+// number of solved positions remembered by the solver, must be power of two
+static const size_t THREAT_CACHE_SIZE = 1U << 14U;
+
+/**
+ * budget of one victory by continuous threats search
+ */
+struct ThreatLimits {
+  int max_depth = VCT_MAX_DEPTH;          // deepest sequence, attacker moves
+  long long node_limit = VCT_NODE_LIMIT;  // searched node budget
+  int time_limit_ms = VCT_TIME_LIMIT_MS;  // wall-clock budget, 0 for none
+  // flag of the caller polled at every node, the search gives up once it
+  // is set. nullptr for none
+  const std::atomic<bool>* stop = nullptr;
+};
+
+/**
+ * solver of forced wins that only considers threats.
+ *
+ * a victory by continuous fours (VCF) is a sequence where every attacker
+ * move makes a four, so the defender has exactly one reply: block the
+ * grid completing five. Attacker wins once a move makes two of those
+ * grids (open four or double four). With one reply per attacker move the
+ * tree is narrow, and sequences far deeper than the full search are read.
+ *
+ * a victory by continuous threats (VCT) also allows moves making an open
+ * three. The defender then has several replies: every empty grid near
+ * the three on its line, and every move making a four of its own. Other
+ * replies let the attacker make an open four. Attacker wins only if every
+ * reply still loses.
+ *
+ * fours are found by sliding a K-grid window over every bitboard line
+ * holding an attacker stone: a window
+ * with four attacker stones and one empty grid is a five threat, a window
+ * with three attacker stones and two empty grids makes a four when
+ * either empty grid is taken. Open threes are classified by the pattern
+ * table of the evaluation, PATTERN_TABLE.
+ *
+ * results only depend on the position, so they are cached across solves.
+ * The solver keeps its own board, one solver must not be shared by
+ * threads.
+ * @tparam N board size
+ * @tparam K number of stones in a row to win
+ */
+template <int N, int K>
+class BasicThreatSolver {
+ public:
+  // bitboard and hash keys of the same board
+  using BitBoard = BasicBitBoard<N, K>;
+  using Zobrist = BasicZobrist<N>;
+  /**
+   * grids where a player has threats, x * N + y each
+   */
+  struct ThreatGrids {
+    int five_num;  // number of grids completing five
+    int fives[N * N];
+    int four_num;  // number of grids making a four
+    int fours[N * N];
+    int three_num;  // number of grids that may make a three
+    int threes[N * N];
+  };
+  /**
+   * create solver with empty board
+   */
+  BasicThreatSolver();
+  /**
+   * search a victory by continuous fours for the attacker, who is to move
+   * @param board board status
+   * @param attacker player to move
+   * @param x row index reference. Updated to the first move if found
+   * @param y column index reference. Updated to the first move if found
+   * @return whether the attacker wins by continuous fours
+   */
+  bool SolveVcf(Stone board[N][N], Stone attacker, int& x, int& y);
+  /**
+   * search a victory by continuous threats for the attacker, who is to
+   * move
+   * @param board board status
+   * @param attacker player to move
+   * @param limits depth, node and time budget
+   * @param x row index reference. Updated to the first move if found
+   * @param y column index reference. Updated to the first move if found
+   * @return whether the attacker wins by continuous threats, false when
+   *         the budget runs out
+   */
+  bool SolveVct(Stone board[N][N], Stone attacker, const ThreatLimits& limits,
+                int& x, int& y);
+  /**
+   * find an empty grid completing five in a row for the player
+   * @param board board status
+   * @param player player to check
+   * @param x row index reference. Updated to the grid if found
+   * @param y column index reference. Updated to the grid if found
+   * @return whether such grid exists
+   */
+  static bool FindFiveMove(Stone board[N][N], Stone player, int& x, int& y);
+  /**
+   * find five threats, four-making grids and grids that may make a three
+   * of a player on the board
+   * @param bits board status
+   * @param player player to check
+   * @param threats threat grids reference, filled with found grids
+   */
+  static void FindThreats(const BitBoard& bits, Stone player,
+                          ThreatGrids& threats);
+  /**
+   * find the grids that block an open three of a player. An open three is
+   * a window of K + 1 grids with both ends empty and K - 2 player stones
+   * in between, every empty grid of the window blocks it
+   * @param bits board status
+   * @param player player owning the threes
+   * @param grids grid array reference, filled with x * N + y each
+   * @return number of found grids
+   */
+  static int FindThreeBlocks(const BitBoard& bits, Stone player, int grids[]);
+  /**
+   * @return number of nodes searched by the latest solve
+   */
+  long long GetNodes() const { return nodes; }
+
+ private:
+  /**
+   * solved position, the attacker is always to move
+   */
+  struct CacheEntry {
+    uint64_t key;  // position hash, marked with attacker and search type
+    int depth;     // depth searched
+    bool win;      // win found within depth, or no win up to depth
+  };
+  /**
+   * victory by continuous fours search, attacker to move
+   * @param attacker attacking player
+   * @param depth remaining attacker moves
+   * @param ply attacker moves made since the root
+   * @return whether the attacker wins
+   */
+  bool SearchVcf(Stone attacker, int depth, int ply);
+  /**
+   * victory by continuous threats search, attacker to move
+   * @param attacker attacking player
+   * @param depth remaining attacker moves
+   * @param ply attacker moves made since the root
+   * @return whether the attacker wins
+   */
+  bool SearchVct(Stone attacker, int depth, int ply);
+  /**
+   * check whether every defender reply to a threat still loses
+   * @param attacker attacking player
+   * @param replies defender replies, x * N + y each
+   * @param reply_num number of replies
+   * @param depth remaining attacker moves after the threat
+   * @param ply attacker moves made since the root
+   * @return whether the attacker wins against all replies
+   */
+  bool SearchVctReplies(Stone attacker, const int replies[], int reply_num,
+                        int depth, int ply);
+  /**
+   * get the best pattern type of the player on a line through given grid,
+   * only patterns within the 7-grid windows covering the grid count
+   * @param x row index
+   * @param y column index
+   * @param player player to check
+   * @param dir direction (row, column, diagonal, anti-diagonal)
+   * @return best pattern type (lower is better), NONE if no pattern
+   */
+  int GetLineType(int x, int y, Stone player, int dir) const;
+  /**
+   * count one node and check the budget
+   * @return whether the budget runs out
+   */
+  bool IsBudgetExceeded();
+  /**
+   * look up a solved position
+   * @param key position key
+   * @param depth remaining depth
+   * @param win result reference, filled when found
+   * @return whether the cached result is valid at given depth
+   */
+  bool LookUp(uint64_t key, int depth, bool& win) const;
+  /**
+   * remember a solved position
+   * @param key position key
+   * @param depth remaining depth
+   * @param win whether a win is found
+   */
+  void Store(uint64_t key, int depth, bool win);
+  /**
+   * find grids completing five with the stone at given position,
+   * only windows through the stone are checked
+   * @param x row index of the stone
+   * @param y column index of the stone
+   * @param grids grid array reference, x * N + y each
+   * @return number of grids found
+   */
+  int FindFivesThrough(int x, int y, int grids[]) const;
+  /**
+   * place a stone and update the hash
+   * @param x row index
+   * @param y column index
+   * @param stone stone type
+   */
+  void Place(int x, int y, Stone stone);
+  /**
+   * remove a stone and update the hash
+   * @param x row index
+   * @param y column index
+   */
+  void Remove(int x, int y);
+
+ private:
+  // board being searched, as array and as bitboard
+  Stone board[N][N];
+  BitBoard bits;
+  // zobrist hash of the board
+  uint64_t hash;
+  // first move of the found sequence
+  int best_x, best_y;
+  // searched nodes of the latest solve
+  long long nodes;
+  // budget of the latest solve
+  long long node_limit;
+  int time_limit_ms;
+  std::chrono::steady_clock::time_point start;
+  const std::atomic<bool>* stop;
+  // set when the budget runs out, results are not cached afterwards
+  bool aborted;
+  // solved positions, index by key
+  std::vector<CacheEntry> cache;
+};
+
+#endif  // FINALPROJECT_THREATSOLVER_H
@@ -0,0 +1,146 @@
+//
+// Transposition table used by alpha-beta search.
+//
+
+#ifndef FINALPROJECT_TRANSPOSITIONTABLE_H
+#define FINALPROJECT_TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// default number of entries in transposition table (16 bytes each).
+// must be power of two, table size is rounded down otherwise.
+static const size_t TRANSPOSITION_TABLE_SIZE = 1U << 20U;
+
+/**
+ * how the stored score relates to the real score of the position
+ */
+enum BoundType {
+  EXACT,        // score is the real minimax score
+  LOWER_BOUND,  // search failed high, real score >= stored score
+  UPPER_BOUND   // search failed low, real score <= stored score
+};
+/**
+ * one searched position stored in transposition table.
+ */
+struct TranspositionEntry {
+  uint64_t key;      // full zobrist key, used to detect index collision
+  int score;         // score of the position
+  int8_t depth;      // remaining search depth when the score is computed
+  uint8_t bound;     // BoundType of the score
+  int8_t row_index;  // best move row index, -1 if unknown
+  int8_t column_index;  // best move column index, -1 if unknown
+};
+/**
+ * fixed-size hash table storing searched positions keyed by zobrist hash.
+ *
+ * the same board is reached by many move orders in gomoku, the table
+ * allow search to reuse the score (cutoffs) and the best move
+ * (move ordering) of positions already searched.
+ *
+ * the table is lock-free and shared by all search threads. Each slot packs
+ * the entry into one 64 bit word and stores it next to key xor word. A slot
+ * torn by concurrent writers fails the xor check and is treated as a miss.
+ */
+class TranspositionTable {
+ public:
+  /**
+   * create table with given number of entries
+   * @param size number of entries, rounded down to power of two
+   */
+  explicit TranspositionTable(size_t size = TRANSPOSITION_TABLE_SIZE);
+  /**
+   * reallocate table with given number of entries, all entries are lost.
+   * @param size number of entries, rounded down to power of two
+   */
+  void Resize(size_t size);
+  /**
+   * remove all entries and reset counters.
+   */
+  void Clear();
+  /**
+   * mark the start of a new search, entries from older search are
+   * replaced first.
+   */
+  void NewSearch();
+  /**
+   * look up position in table, update hit or miss counter
+   * @param key zobrist key of the position
+   * @param entry entry reference, filled when position is found
+   * @return whether position is found
+   */
+  bool Probe(uint64_t key, TranspositionEntry& entry);
+  /**
+   * save searched position into table
+   * @param key zobrist key of the position
+   * @param depth remaining search depth
+   * @param bound bound type of the score
+   * @param score score of the position
+   * @param x best move row index (-1 if none)
+   * @param y best move column index (-1 if none)
+   */
+  void Store(uint64_t key, int depth, BoundType bound, int score, int x,
+             int y);
+  /**
+   * reset hit and miss counter
+   */
+  void ResetCounters();
+  /**
+   * @return number of successful probe since last reset
+   */
+  long long GetHits() const { return hits.load(std::memory_order_relaxed); }
+  /**
+   * @return number of failed probe since last reset
+   */
+  long long GetMisses() const {
+    return misses.load(std::memory_order_relaxed);
+  }
+  /**
+   * @return number of entries in the table
+   */
+  size_t GetSize() const { return mask + 1; }
+
+ private:
+  /**
+   * one table slot, the packed entry and key xor packed entry
+   */
+  struct Slot {
+    std::atomic<uint64_t> check;
+    std::atomic<uint64_t> data;
+  };
+  /**
+   * pack entry fields into one word: score in the low 32 bits, then
+   * depth and bound, best move, and search generation in the top byte.
+   * @param depth remaining search depth (at most 63)
+   * @param bound bound type of the score
+   * @param score score of the position
+   * @param x best move row index (-1 if none)
+   * @param y best move column index (-1 if none)
+   * @param generation search generation
+   * @return packed word
+   */
+  static uint64_t Pack(int depth, BoundType bound, int score, int x, int y,
+                       uint8_t generation);
+  /**
+   * unpack word into entry fields (except key)
+   * @param data packed word
+   * @param entry entry reference
+   */
+  static void Unpack(uint64_t data, TranspositionEntry& entry);
+
+ private:
+  // all table slots
+  std::unique_ptr<Slot[]> slots;
+  // index mask (table size minus one)
+  size_t mask;
+  // current search generation
+  std::atomic<uint8_t> generation;
+  // successful probe count
+  std::atomic<long long> hits;
+  // failed probe count
+  std::atomic<long long> misses;
+};
+
+#endif  // FINALPROJECT_TRANSPOSITIONTABLE_H
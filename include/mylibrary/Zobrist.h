@@ -0,0 +1,150 @@
+//
+// Zobrist hashing for gomoku board status.
+//
+
+#ifndef FINALPROJECT_ZOBRIST_H
+#define FINALPROJECT_ZOBRIST_H
+
+#include <cstdint>
+
+#include "Game.h"
+
+// number of board symmetries: four rotations, each optionally mirrored
+static const int SYMMETRY_NUM = 8;
+
+/**
+ * zobrist keys used to hash board status.
+ *
+ * every (grid, stone type) pair owns a random 64 bit key, the hash of a board
+ * is the xor of keys of all occupied grids. Since xor is its own inverse,
+ * placing or removing a stone only need to xor a single key into the hash.
+ * every board size N has its own keys.
+ */
+template <int N>
+class BasicZobrist {
+ public:
+  /**
+   * get the key of given stone at given position
+   * @param x row coordinate
+   * @param y column coordinate
+   * @param stone stone type (black or white)
+   * @return zobrist key of the stone
+   */
+  static uint64_t Key(int x, int y, Stone stone) { return keys[x][y][stone]; }
+  /**
+   * get the key used to mark the player to move
+   * @param player player to move
+   * @return zobrist key of the player
+   */
+  static uint64_t TurnKey(Stone player) { return turn_keys[player]; }
+  /**
+   * get the key of given stone at the image of given position under a
+   * board symmetry
+   * @param symmetry symmetry index, 0 to SYMMETRY_NUM - 1
+   * @param x row coordinate
+   * @param y column coordinate
+   * @param stone stone type (black or white)
+   * @return zobrist key of the mapped stone
+   */
+  static uint64_t SymmetricKey(int symmetry, int x, int y, Stone stone) {
+    return symmetric_keys[symmetry][x][y][stone];
+  }
+  /**
+   * compute the hash of the whole board from scratch.
+   * @param board board status
+   * @return zobrist hash of the board
+   */
+  static uint64_t Hash(Stone board[N][N]);
+  /**
+   * compute the smallest hash among the eight symmetric images of the
+   * board, so that symmetric boards get the same hash.
+   * @param board board status
+   * @param symmetry symmetry reference, updated to the one mapping the
+   *        board to the image with that hash
+   * @return canonical hash of the board
+   */
+  static uint64_t CanonicalHash(Stone board[N][N], int& symmetry);
+  /**
+   * map a grid by a board symmetry. Bit 0 mirrors the row coordinate,
+   * bit 1 mirrors the column coordinate, bit 2 then swaps them
+   * @param symmetry symmetry index, 0 to SYMMETRY_NUM - 1
+   * @param x row coordinate
+   * @param y column coordinate
+   * @param new_x mapped row coordinate reference
+   * @param new_y mapped column coordinate reference
+   */
+  static void Transform(int symmetry, int x, int y, int& new_x, int& new_y);
+  /**
+   * map a grid back by the inverse of a board symmetry
+   * @param symmetry symmetry index, 0 to SYMMETRY_NUM - 1
+   * @param x mapped row coordinate
+   * @param y mapped column coordinate
+   * @param new_x original row coordinate reference
+   * @param new_y original column coordinate reference
+   */
+  static void InverseTransform(int symmetry, int x, int y, int& new_x,
+                               int& new_y);
+
+ private:
+  /**
+   * fill all key tables with pseudo random numbers from a fixed seed,
+   * so that the same board always get the same hash.
+   * @return always true
+   */
+  static bool InitKeys();
+
+ private:
+  // key of every grid and stone type, empty grid keys are zero
+  static uint64_t keys[N][N][3];
+  // key of every grid and stone type after each board symmetry
+  static uint64_t symmetric_keys[SYMMETRY_NUM][N][N][3];
+  // key of player to move
+  static uint64_t turn_keys[3];
+  // forces key initialization before main
+  static bool initialized;
+};
+
+/**
+ * zobrist hashes of the eight symmetric images of a board, updated together
+ * when a stone is placed or removed.
+ *
+ * the smallest of them is the same for all images, so symmetric positions
+ * share one canonical hash without scanning the board for each of them.
+ */
+template <int N>
+struct BasicSymmetricHash {
+  // hash of each image, index by symmetry. Symmetry 0 is the board itself
+  uint64_t hashes[SYMMETRY_NUM];
+  /**
+   * compute all hashes from scratch
+   * @param board board status
+   */
+  void Init(Stone board[N][N]);
+  /**
+   * place or remove a stone, both xor the same keys
+   * @param x row coordinate
+   * @param y column coordinate
+   * @param stone stone type (black or white)
+   */
+  void Toggle(int x, int y, Stone stone) {
+    for (int s = 0; s < SYMMETRY_NUM; s++)
+      hashes[s] ^= BasicZobrist<N>::SymmetricKey(s, x, y, stone);
+  }
+  /**
+   * @return hash of the board itself, same as Zobrist::Hash
+   */
+  uint64_t Hash() const { return hashes[0]; }
+  /**
+   * get the smallest hash, the first symmetry on ties
+   * @param symmetry symmetry reference, updated to the one mapping the
+   *        board to the image with that hash
+   * @return canonical hash of the board
+   */
+  uint64_t Canonical(int& symmetry) const;
+};
+
+// hashing of the standard board
+using Zobrist = BasicZobrist<Game::BOARD_SIZE>;
+using SymmetricHash = BasicSymmetricHash<Game::BOARD_SIZE>;
+
+#endif  // FINALPROJECT_ZOBRIST_H
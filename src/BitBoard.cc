@@ -0,0 +1,160 @@
+//
+// Bitboard representation of gomoku board status.
+//
+
+#include "mylibrary/BitBoard.h"
+
+#include <algorithm>
+#include <cstring>
+
+template <int N, int K>
+BasicBitBoard<N, K>::BasicBitBoard() {
+  Clear();
+}
+
+template <int N, int K>
+BasicBitBoard<N, K>::BasicBitBoard(Stone board[N][N]) {
+  Clear();
+  for (int x = 0; x < N; x++)
+    for (int y = 0; y < N; y++)
+      if (board[x][y] != Stone::EMPTY) Place(x, y, board[x][y]);
+}
+
+template <int N, int K>
+void BasicBitBoard<N, K>::Clear() {
+  memset(rows, 0, sizeof(rows));
+  memset(columns, 0, sizeof(columns));
+  memset(diagonals, 0, sizeof(diagonals));
+  memset(anti_diagonals, 0, sizeof(anti_diagonals));
+}
+
+template <int N, int K>
+void BasicBitBoard<N, K>::Place(int x, int y, Stone stone) {
+  int c = stone - 1;
+  rows[c][x] |= 1U << static_cast<unsigned>(y);
+  columns[c][y] |= 1U << static_cast<unsigned>(x);
+  diagonals[c][x - y + N - 1] |= 1U << static_cast<unsigned>(x);
+  anti_diagonals[c][x + y] |= 1U << static_cast<unsigned>(x);
+}
+
+template <int N, int K>
+void BasicBitBoard<N, K>::Remove(int x, int y, Stone stone) {
+  int c = stone - 1;
+  rows[c][x] &= ~(1U << static_cast<unsigned>(y));
+  columns[c][y] &= ~(1U << static_cast<unsigned>(x));
+  diagonals[c][x - y + N - 1] &= ~(1U << static_cast<unsigned>(x));
+  anti_diagonals[c][x + y] &= ~(1U << static_cast<unsigned>(x));
+}
+
+template <int N, int K>
+Stone BasicBitBoard<N, K>::Get(int x, int y) const {
+  if ((rows[0][x] >> static_cast<unsigned>(y)) & 1U) return Stone::BLACK;
+  if ((rows[1][x] >> static_cast<unsigned>(y)) & 1U) return Stone::WHITE;
+  return Stone::EMPTY;
+}
+
+template <int N, int K>
+bool BasicBitBoard<N, K>::HasFive(uint32_t line, int bit) {
+  // bit i of run is set when bits i to i + K - 1 of line are all set
+  uint32_t run = line;
+  for (int i = 1; i < K; i++) run &= line >> static_cast<unsigned>(i);
+  // runs starting from bit - K + 1 to bit cover the bit
+  uint32_t start = ((1U << K) - 1U) << static_cast<unsigned>(bit);
+  return (run & (start >> (K - 1U))) != 0;
+}
+
+template <int N, int K>
+bool BasicBitBoard<N, K>::IsWin(int x, int y) const {
+  Stone stone = Get(x, y);
+  if (stone == Stone::EMPTY) return false;
+  int c = stone - 1;
+  return HasFive(rows[c][x], y) || HasFive(columns[c][y], x) ||
+         HasFive(diagonals[c][x - y + N - 1], x) ||
+         HasFive(anti_diagonals[c][x + y], x);
+}
+
+template <int N, int K>
+uint32_t BasicBitBoard<N, K>::Dilate(uint32_t line, int range) {
+  uint32_t result = line;
+  for (unsigned i = 1; i <= static_cast<unsigned>(range); i++)
+    result |= (line << i) | (line >> i);
+  return result & LINE_MASK;
+}
+
+template <int N, int K>
+bool BasicBitBoard<N, K>::HasNeighbor(int x, int y, int range) const {
+  // grids from y - range to y + range of a row
+  uint32_t window = Dilate(1U << static_cast<unsigned>(y), range);
+  for (int new_x = x - range; new_x <= x + range; new_x++) {
+    if (new_x < 0 || new_x >= N) continue;
+    if ((rows[0][new_x] | rows[1][new_x]) & window) return true;
+  }
+  return false;
+}
+
+template <int N, int K>
+void BasicBitBoard<N, K>::GetNeighbors(int range, uint32_t neighbors[N]) const {
+  // dilate every row horizontally first
+  uint32_t spread[N];
+  for (int x = 0; x < N; x++)
+    spread[x] = Dilate(rows[0][x] | rows[1][x], range);
+  // then vertically, and keep empty grids only
+  for (int x = 0; x < N; x++) {
+    uint32_t near = 0;
+    for (int new_x = x - range; new_x <= x + range; new_x++)
+      if (new_x >= 0 && new_x < N) near |= spread[new_x];
+    neighbors[x] = near & ~(rows[0][x] | rows[1][x]);
+  }
+}
+
+template <int N, int K>
+uint32_t BasicBitBoard<N, K>::GetLine(Stone stone, int dir, int index) const {
+  int c = stone - 1;
+  switch (dir) {
+    case 0:
+      return rows[c][index];
+    case 1:
+      return columns[c][index];
+    case 2:
+      return diagonals[c][index];
+    default:
+      return anti_diagonals[c][index];
+  }
+}
+
+template <int N, int K>
+uint32_t BasicBitBoard<N, K>::GetLineMask(int dir, int index) {
+  if (dir < 2) return LINE_MASK;
+  // bits from the first to the last x coordinate of the line, the same
+  // for diagonals (y = x - index + N - 1) and anti-diagonals (y = index - x)
+  int first = std::max(index - (N - 1), 0);
+  int last = std::min(index, N - 1);
+  return ((2U << static_cast<unsigned>(last)) - 1U) &
+         ~((1U << static_cast<unsigned>(first)) - 1U);
+}
+
+template <int N, int K>
+void BasicBitBoard<N, K>::GetLineGrid(int dir, int index, int bit, int& x,
+                                      int& y) {
+  switch (dir) {
+    case 0:
+      x = index;
+      y = bit;
+      break;
+    case 1:
+      x = bit;
+      y = index;
+      break;
+    case 2:
+      x = bit;
+      y = bit - index + N - 1;
+      break;
+    default:
+      x = bit;
+      y = index - bit;
+      break;
+  }
+}
+
+#define INSTANTIATE_BITBOARD(N, K) template class BasicBitBoard<N, K>;
+FOR_EACH_BOARD_VARIANT(INSTANTIATE_BITBOARD)
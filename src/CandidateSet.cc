@@ -0,0 +1,60 @@
+//
+// Candidate moves maintained incrementally during search.
+//
+
+#include "mylibrary/CandidateSet.h"
+
+#include <algorithm>
+#include <cstring>
+
+template <int N>
+BasicCandidateSet<N>::BasicCandidateSet() : range(0) {
+  memset(count, 0, sizeof(count));
+  memset(occupied, 0, sizeof(occupied));
+  memset(rows, 0, sizeof(rows));
+}
+
+template <int N>
+void BasicCandidateSet<N>::Init(Stone board[N][N], int search_range) {
+  range = search_range;
+  memset(count, 0, sizeof(count));
+  memset(occupied, 0, sizeof(occupied));
+  memset(rows, 0, sizeof(rows));
+  for (int x = 0; x < N; x++)
+    for (int y = 0; y < N; y++)
+      if (board[x][y] != Stone::EMPTY) Place(x, y);
+}
+
+template <int N>
+void BasicCandidateSet<N>::Place(int x, int y) {
+  occupied[x] |= 1U << static_cast<unsigned>(y);
+  rows[x] &= ~(1U << static_cast<unsigned>(y));
+  // every empty grid around the stone becomes a candidate
+  int min_y = std::max(y - range, 0);
+  int max_y = std::min(y + range, N - 1);
+  uint32_t window = ((2U << static_cast<unsigned>(max_y)) - 1U) &
+                    ~((1U << static_cast<unsigned>(min_y)) - 1U);
+  int max_x = std::min(x + range, N - 1);
+  for (int i = std::max(x - range, 0); i <= max_x; i++) {
+    for (int j = min_y; j <= max_y; j++) count[i][j]++;
+    rows[i] |= window & ~occupied[i];
+  }
+}
+
+template <int N>
+void BasicCandidateSet<N>::Remove(int x, int y) {
+  occupied[x] &= ~(1U << static_cast<unsigned>(y));
+  // grids without any other stone around are no longer candidates
+  int min_y = std::max(y - range, 0);
+  int max_y = std::min(y + range, N - 1);
+  int max_x = std::min(x + range, N - 1);
+  for (int i = std::max(x - range, 0); i <= max_x; i++) {
+    for (int j = min_y; j <= max_y; j++)
+      if (--count[i][j] == 0) rows[i] &= ~(1U << static_cast<unsigned>(j));
+  }
+  // the emptied grid is a candidate if other stones are near it
+  if (count[x][y] > 0) rows[x] |= 1U << static_cast<unsigned>(y);
+}
+
+#define INSTANTIATE_CANDIDATE_SET(N, K) template class BasicCandidateSet<N>;
+FOR_EACH_BOARD_VARIANT(INSTANTIATE_CANDIDATE_SET)
@@ -4,8 +4,13 @@
 #include "mylibrary/Game.h"
 
 #include <cstring>
-Game::Game() { Reset(); }
-void Game::Reset() {
+
+template <int N, int K>
+BasicGame<N, K>::BasicGame() {
+  Reset();
+}
+template <int N, int K>
+void BasicGame<N, K>::Reset() {
   // reset all grid to empty
   std::memset(mChessStatus, Stone::EMPTY,
               sizeof(int) * BOARD_SIZE * BOARD_SIZE);
@@ -13,9 +18,12 @@ void Game::Reset() {
   mCurrentRole = Stone::BLACK;
   // reset winner to empty
   mWinner = Stone::EMPTY;
+  mBitBoard = BasicBitBoard<N, K>();
 }
-Stone Game::GetRole() { return mCurrentRole; }
-Stone Game::Play(int row_index, int column_index) {
+template <int N, int K>
+Stone BasicGame<N, K>::GetRole() { return mCurrentRole; }
+template <int N, int K>
+Stone BasicGame<N, K>::Play(int row_index, int column_index) {
   // if given position is out of range, return -1.
   if (row_index < 0 || row_index >= BOARD_SIZE || column_index < 0 ||
       column_index >= BOARD_SIZE) {
@@ -26,9 +34,10 @@ Stone Game::Play(int row_index, int column_index) {
   }
   // place a stone at given position
   mChessStatus[row_index][column_index] = mCurrentRole;
+  mBitBoard.Place(row_index, column_index, mCurrentRole);
   // if has winner, update winner, and set player to empty
   // otherwise switch current game player
-  if (IsWin(mChessStatus, row_index, column_index)) {
+  if (mBitBoard.IsWin(row_index, column_index)) {
     mWinner = mCurrentRole;
     mCurrentRole = Stone::EMPTY;
   } else if (mCurrentRole == 1) {
@@ -38,7 +47,8 @@ Stone Game::Play(int row_index, int column_index) {
   }
   return mWinner;
 }
-Stone Game::GetStatus(int row_index, int column_index) {
+template <int N, int K>
+Stone BasicGame<N, K>::GetStatus(int row_index, int column_index) {
   // if given position is out of range, return -1.
   if (row_index < 0 || row_index >= BOARD_SIZE || column_index < 0 ||
       column_index >= BOARD_SIZE) {
@@ -46,67 +56,6 @@ Stone Game::GetStatus(int row_index, int column_index) {
   }
   return mChessStatus[row_index][column_index];
 }
-bool Game::IsWin(Stone board[BOARD_SIZE][BOARD_SIZE], int x, int y) {
-  return IsColumnWin(board, x, y) || IsRowWin(board, x, y) ||
-         IsDiagonalWin(board, x, y) || IsAntiDiagonalWIn(board, x, y);
-}
-bool Game::IsColumnWin(Stone board[BOARD_SIZE][BOARD_SIZE], int x, int y) {
-  int count = 0;
-  // go downwards
-  int new_y = y;
-  while (--new_y >= 0 && board[x][new_y] == board[x][y]) count++;
-  // go upwards
-  new_y = y;
-  while (++new_y < BOARD_SIZE && board[x][new_y] == board[x][y]) count++;
-  // return whether win based on consecutive count.
-  return count >= WINNING_THRESHOLD - 1;
-}
-bool Game::IsRowWin(Stone board[BOARD_SIZE][BOARD_SIZE], int x, int y) {
-  int count = 0;
-  int new_x = x;
-  // go right
-  while (++new_x < BOARD_SIZE && board[new_x][y] == board[x][y]) count++;
-  // go left
-  new_x = x;
-  while (--new_x >= 0 && board[new_x][y] == board[x][y]) count++;
-  // return whether win based on consecutive count.
-  return count >= WINNING_THRESHOLD - 1;
-}
-bool Game::IsDiagonalWin(Stone board[BOARD_SIZE][BOARD_SIZE], int x, int y) {
-  int new_x = x;
-  int new_y = y;
-  int count = 0;
-  // go bottom left
-  while (--new_x >= 0 && --new_y >= 0 && board[new_x][new_y] == board[x][y]) {
-    count++;
-  }
-  // go upper right
-  new_x = x;
-  new_y = y;
-  while (++new_x < BOARD_SIZE && ++new_y < BOARD_SIZE &&
-         board[new_x][new_y] == board[x][y]) {
-    count++;
-  }
-  // return whether win based on consecutive count.
-  return count >= WINNING_THRESHOLD - 1;
-}
-bool Game::IsAntiDiagonalWIn(Stone board[BOARD_SIZE][BOARD_SIZE], int x,
-                             int y) {
-  int count = 0;
-  // go bottom right
-  int new_x = x;
-  int new_y = y;
-  while (++new_x < BOARD_SIZE && --new_y >= 0 &&
-         board[new_x][new_y] == board[x][y]) {
-    count++;
-  }
-  // go upper left
-  new_x = x;
-  new_y = y;
-  while (--new_x >= 0 && ++new_y < BOARD_SIZE &&
-         board[new_x][new_y] == board[x][y]) {
-    count++;
-  }
-  // return whether win based on consecutive count.
-  return count >= WINNING_THRESHOLD - 1;
-}
+
+#define INSTANTIATE_GAME(N, K) template class BasicGame<N, K>;
+FOR_EACH_BOARD_VARIANT(INSTANTIATE_GAME)
@@ -0,0 +1,268 @@
+//
+// Pattern scoring of many board lines at once.
+//
+
+#include "mylibrary/LineScorer.h"
+
+#include "mylibrary/PatternTable.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+#define LINE_SCORER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// msvc emits any instruction set without a target attribute
+#define LINE_SCORER_AVX2
+#else
+#define LINE_SCORER_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define LINE_SCORER_X86 0
+#endif
+
+namespace {
+// grids of a line address
+const int LINE_WINDOW = BIT_DATA_LENGTH / 2;
+// lines scanned together by the vector kernel
+const int LANES = 8;
+
+/**
+ * first grid of every line as board offset x * N + y, the offset between its
+ * consecutive grids in scan order, and its number of grids
+ * @tparam N board size
+ */
+template <int N>
+struct LineLayout {
+  int start[BasicLineScorer<N>::LINE_NUM];
+  int step[BasicLineScorer<N>::LINE_NUM];
+  int length[BasicLineScorer<N>::LINE_NUM];
+};
+
+template <int N>
+constexpr LineLayout<N> MakeLineLayout() {
+  LineLayout<N> layout{};
+  const int* offset = BasicLineScorer<N>::LINE_OFFSET;
+  for (int i = 0; i < N; i++) {
+    // row i runs along the first coordinate, column i along the second
+    layout.start[offset[0] + i] = i;
+    layout.step[offset[0] + i] = N;
+    layout.length[offset[0] + i] = N;
+    layout.start[offset[1] + i] = i * N;
+    layout.step[offset[1] + i] = 1;
+    layout.length[offset[1] + i] = N;
+    // lower half of the diagonals first, then the upper half, which shares
+    // the main diagonal. anti-diagonals start at the last row and go up
+    int lower = offset[2] + i, upper = offset[2] + i + N - 1;
+    layout.start[lower] = i * N;
+    layout.start[upper] = i;
+    layout.step[lower] = layout.step[upper] = N + 1;
+    layout.length[lower] = layout.length[upper] = N - i;
+    lower = offset[3] + i, upper = offset[3] + i + N - 1;
+    layout.start[lower] = (N - 1 - i) * N;
+    layout.start[upper] = (N - 1) * N + i;
+    layout.step[lower] = layout.step[upper] = 1 - N;
+    layout.length[lower] = layout.length[upper] = N - i;
+  }
+  return layout;
+}
+
+template <int N>
+constexpr LineLayout<N> LINE_LAYOUT = MakeLineLayout<N>();
+
+// upper half diagonal starting at column 2, and the last anti-diagonal
+static_assert(
+    LINE_LAYOUT<Game::BOARD_SIZE>.start[3 * Game::BOARD_SIZE + 1] == 2,
+    "line layout is not generated");
+static_assert(LINE_LAYOUT<Game::BOARD_SIZE>.start[LineScorer::LINE_NUM - 1] ==
+                  Game::BOARD_SIZE * Game::BOARD_SIZE - 1,
+              "line layout is not generated");
+
+/**
+ * @param stone stone of a grid
+ * @return the stone as seen by white: black and white swapped
+ */
+int SwapColor(int stone) {
+  return ((stone << 1) | (stone >> 1)) & 3;  // NOLINT
+}
+
+#if LINE_SCORER_X86
+/**
+ * keep the best score of the lanes for a window address
+ * @param addr line addresses of the lanes
+ * @param inside lanes whose window is still on the line
+ * @param score best score reference
+ * @param type best type reference
+ */
+LINE_SCORER_AVX2 inline void UpdateBest(__m256i addr, __m256i inside,
+                                        __m256i& score, __m256i& type) {
+  __m256i entry = _mm256_i32gather_epi32(
+      reinterpret_cast<const int*>(PATTERN_TABLE.entry), addr, 4);
+  __m256i value = _mm256_srli_epi32(entry, PATTERN_TYPE_BITS);
+  __m256i better =
+      _mm256_and_si256(_mm256_cmpgt_epi32(value, score), inside);
+  score = _mm256_blendv_epi8(score, value, better);
+  type = _mm256_blendv_epi8(
+      type,
+      _mm256_and_si256(entry, _mm256_set1_epi32((1 << PATTERN_TYPE_BITS) - 1)),
+      better);
+}
+
+/**
+ * AVX2 kernel of BasicLineScorer, 8 lines in each step. The target
+ * attribute is not taken from the definition of a class member, so the
+ * kernel is a free function
+ * @tparam N board size
+ * @param board board status
+ * @param lines line indices
+ * @param count number of lines, a multiple of the lanes
+ * @param scores line scores
+ */
+template <int N>
+LINE_SCORER_AVX2 void ScanLinesAvx2(
+    Stone board[N][N], const int* lines, int count,
+    typename BasicLineScorer<N>::Scores* scores) {
+  static_assert(sizeof(Stone) == sizeof(int), "grids are gathered as int");
+  const int* grids = reinterpret_cast<const int*>(&board[0][0]);
+  const __m256i window_mask = _mm256_set1_epi32(BIT_DATA_SIZE);
+  const __m256i two_bits = _mm256_set1_epi32(3);
+  for (int k = 0; k < count; k += LANES) {
+    __m256i line =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lines + k));
+    __m256i length = _mm256_i32gather_epi32(LINE_LAYOUT<N>.length, line, 4);
+    __m256i offset = _mm256_i32gather_epi32(LINE_LAYOUT<N>.start, line, 4);
+    __m256i step = _mm256_i32gather_epi32(LINE_LAYOUT<N>.step, line, 4);
+    __m256i addr[2] = {_mm256_setzero_si256(), _mm256_setzero_si256()};
+    __m256i score[2] = {_mm256_setzero_si256(), _mm256_setzero_si256()};
+    __m256i type[2] = {_mm256_setzero_si256(), _mm256_setzero_si256()};
+    for (int j = 0; j < N; j++) {
+      // lanes past the end of their line read no grid and keep their score
+      __m256i inside = _mm256_cmpgt_epi32(length, _mm256_set1_epi32(j));
+      __m256i stone = _mm256_mask_i32gather_epi32(
+          _mm256_setzero_si256(), grids, offset, inside, 4);
+      offset = _mm256_add_epi32(offset, step);
+      __m256i swapped = _mm256_and_si256(
+          _mm256_or_si256(_mm256_slli_epi32(stone, 1),
+                          _mm256_srli_epi32(stone, 1)),
+          two_bits);
+      addr[0] = _mm256_and_si256(
+          _mm256_or_si256(_mm256_slli_epi32(addr[0], 2), stone), window_mask);
+      addr[1] = _mm256_and_si256(
+          _mm256_or_si256(_mm256_slli_epi32(addr[1], 2), swapped),
+          window_mask);
+      if (j < LINE_WINDOW - 1) continue;
+      UpdateBest(addr[0], inside, score[0], type[0]);
+      UpdateBest(addr[1], inside, score[1], type[1]);
+    }
+    int lane_score[2][LANES], lane_type[2][LANES];
+    for (int c = 0; c < 2; c++) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(lane_score[c]), score[c]);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(lane_type[c]), type[c]);
+    }
+    for (int l = 0; l < LANES; l++) {
+      for (int c = 0; c < 2; c++) {
+        scores->score[c][lines[k + l]] = lane_score[c][l];
+        scores->type[c][lines[k + l]] = lane_type[c][l];
+      }
+    }
+  }
+}
+
+bool CpuHasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) return false;
+  // the processor supports avx, and the system saves its registers
+  __cpuid(info, 1);
+  const int os_saves = 1 << 27, avx = 1 << 28;
+  if ((info[2] & os_saves) == 0 || (info[2] & avx) == 0) return false;
+  if ((_xgetbv(0) & 6) != 6) return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  // also checks that the system saves the registers
+  return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif
+
+// whether the processor supports AVX2, checked once
+#if LINE_SCORER_X86
+const bool avx2_supported = CpuHasAvx2();
+#else
+const bool avx2_supported = false;
+#endif
+// whether the scalar scan is forced, shared by every board size
+bool force_scalar = false;
+}  // namespace
+
+template <int N>
+bool BasicLineScorer<N>::IsVectorized() {
+  return avx2_supported && !force_scalar;
+}
+
+template <int N>
+void BasicLineScorer<N>::SetScalar(bool scalar) {
+  force_scalar = scalar;
+}
+
+template <int N>
+void BasicLineScorer<N>::ScoreLines(Stone board[N][N], const int* lines,
+                                    int count, Scores* scores) {
+  // lanes of a partial group would idle, the rest is faster in scalar
+  int vector_count = IsVectorized() ? count - count % LANES : 0;
+  if (vector_count > 0) ScoreLinesAvx2(board, lines, vector_count, scores);
+  ScoreLinesScalar(board, lines + vector_count, count - vector_count, scores);
+}
+
+template <int N>
+void BasicLineScorer<N>::ScoreBoard(Stone board[N][N], Scores* scores) {
+  int lines[LINE_NUM];
+  for (int line = 0; line < LINE_NUM; line++) lines[line] = line;
+  ScoreLines(board, lines, LINE_NUM, scores);
+}
+
+template <int N>
+void BasicLineScorer<N>::ScoreLinesScalar(Stone board[N][N], const int* lines,
+                                          int count, Scores* scores) {
+  for (int k = 0; k < count; k++) {
+    int line = lines[k];
+    const Stone* grid = &board[0][0] + LINE_LAYOUT<N>.start[line];
+    int addr[2] = {0, 0};
+    int best_score[2] = {0, 0};
+    int best_type[2] = {NONE, NONE};
+    for (int j = 0; j < LINE_LAYOUT<N>.length[line];
+         j++, grid += LINE_LAYOUT<N>.step[line]) {
+      int stone = *grid;
+      // black stones append 01, white stones 10, for white the other way
+      addr[0] = ((addr[0] << 2) | stone) & BIT_DATA_SIZE;             // NOLINT
+      addr[1] = ((addr[1] << 2) | SwapColor(stone)) & BIT_DATA_SIZE;  // NOLINT
+      if (j < LINE_WINDOW - 1) continue;
+      for (int c = 0; c < 2; c++) {
+        uint32_t entry = PATTERN_TABLE.entry[addr[c]];
+        if (GetPatternScore(entry) > best_score[c]) {
+          best_score[c] = GetPatternScore(entry);
+          best_type[c] = GetPatternType(entry);
+        }
+      }
+    }
+    for (int c = 0; c < 2; c++) {
+      scores->score[c][line] = best_score[c];
+      scores->type[c][line] = best_type[c];
+    }
+  }
+}
+
+template <int N>
+void BasicLineScorer<N>::ScoreLinesAvx2(Stone board[N][N], const int* lines,
+                                        int count, Scores* scores) {
+#if LINE_SCORER_X86
+  ScanLinesAvx2<N>(board, lines, count, scores);
+#else
+  ScoreLinesScalar(board, lines, count, scores);
+#endif
+}
+
+#define INSTANTIATE_LINE_SCORER(N, K) template class BasicLineScorer<N>;
+FOR_EACH_BOARD_VARIANT(INSTANTIATE_LINE_SCORER)
@@ -1,309 +1,985 @@
 #include <mylibrary/Game.h>
+#include <mylibrary/LineScorer.h>
 #include <mylibrary/MiniMax.h>
 
 #include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
 using std::max;
 using std::min;
 
-AlphaBetaAlgorithm::AlphaBetaAlgorithm() { InitScoreTable(); }
-
-void AlphaBetaAlgorithm::InitScoreTable() {
-  // reset score table and score table type array
-  memset(score_table, 0, sizeof(score_table));
-  memset(score_type_table, 0, sizeof(score_type_table));
-  // iterator through every gomoku type
-  for (auto& i : pattern) {
-    int mask1 = 0;  // forward mask
-    int mask2 = 0;  // backward mask
-    int length = strlen(i.string_pattern);
-    for (int j = 0; j < length; j++) {
-      mask1 <<= 2;  // NOLINT
-      mask2 <<= 2;  // NOLINT
-      // update forward mask
-      switch (i.string_pattern[j]) {
-        case '1':
-          mask1 |= 1;  // NOLINT
-          break;
-        case '2':
-          mask1 |= 2;  // NOLINT
-          break;
-      }
-      // update backward mask
-      switch (i.string_pattern[length - j - 1]) {
-        case '1':
-          mask2 |= 1;  // NOLINT
-          break;
-        case '2':
-          mask2 |= 2;  // NOLINT
-          break;
-      }
-    }
-    // check if address contains target mask snippet
-    // if yes, record current address to score convertion table
-    for (int addr = 0; addr < BIT_DATA_SIZE; addr++) {
-      if (score_table[addr] == 0) {
-        if (IsAddrContainsMask(addr, BIT_DATA_LENGTH, mask1, length * 2) ||
-            IsAddrContainsMask(addr, BIT_DATA_LENGTH, mask2, length * 2)) {
-          score_table[addr] = i.score;
-          score_type_table[addr] = i.type;
-        }
-      }
-    }
-  }
+template <int N, int K>
+BasicAlphaBetaAlgorithm<N, K>::BasicAlphaBetaAlgorithm(size_t table_size)
+    : transposition_table(table_size),
+      threat_probe(true),
+      move_ordering(true),
+      principal_variation(true),
+      stop_search(false),
+      node_count(0),
+      completed_depth(0),
+      best_value(0),
+      winning_move(false),
+      forced_move(false),
+      threat_nodes(0),
+      book_move(false),
+      ponder_hit(false),
+      reduced_moves(0),
+      reduction_failures(0),
+      futility_prunes(0),
+      quiescence_nodes(0),
+      parallel_mode(ROOT_SPLIT),
+      thread_num(0),
+      root_random(std::random_device()()),
+      split_search(false),
+      background_id(0),
+      search_count(0),
+      background_player(Stone::EMPTY),
+      background_x(-1),
+      background_y(-1),
+      pondering(false),
+      ponder_x(-1),
+      ponder_y(-1),
+      search_deadline(0),
+      progress_depth(0),
+      progress_value(0),
+      progress_move(-1) {
+  InitScoreTable();
+  for (auto& color : history)
+    for (auto& row : color)
+      for (auto& grid : row) grid.store(0);
 }
 
-bool AlphaBetaAlgorithm::IsAddrContainsMask(int addr, int addrBitCount,
-                                            int mask, int maskBitCount) {
-  int k = 0;
-  // create a temp number k with max binary number with length maskBitCount.
-  for (int i = 0; i < maskBitCount; i++) k |= 1 << i;  // NOLINT
-  // find target bit data in address number.
-  for (int i = maskBitCount; i <= addrBitCount; i += 2) {
-    if ((addr & k) == mask) return true;  // NOLINT
-    mask <<= 2;                           // NOLINT
-    k <<= 2;                              // NOLINT
-  }
-  return false;
+template <int N, int K>
+BasicAlphaBetaAlgorithm<N, K>::~BasicAlphaBetaAlgorithm() { StopSearch(); }
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SetTranspositionTableSize(
+    size_t table_size) {
+  StopSearch();
+  transposition_table.Resize(table_size);
 }
 
-bool AlphaBetaAlgorithm::IsValidPosition(
-    Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE], int x, int y) {
-  // check if there's an occupied grid within given position
-  for (int dx = -SEARCH_RANGE; dx <= SEARCH_RANGE; dx++) {
-    for (int dy = -SEARCH_RANGE; dy <= SEARCH_RANGE; dy++) {
-      int new_x = x + dx;
-      int new_y = y + dy;
-      // if new coordinate is out of range, skip this grid
-      if (new_x < 0 || new_x >= Game::BOARD_SIZE || new_y < 0 ||
-          new_y >= Game::BOARD_SIZE) {
-        continue;
-      }
-      // if current grid is occupied, condition is satisfied
-      if (board[new_x][new_y] != Stone::EMPTY) return true;
-    }
-  }
-  return false;
+template <int N, int K>
+bool BasicAlphaBetaAlgorithm<N, K>::LoadOpeningBook(const std::string& path) {
+  StopSearch();
+  return opening_book.Open(path, N, K);
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SetParallelMode(ParallelMode mode) {
+  StopSearch();
+  parallel_mode = mode;
 }
 
-CandidatePosition* AlphaBetaAlgorithm::SearchCandidatePosition(
-    Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE], Stone player) {
-  CandidatePosition* pRoot = nullptr;
-  // iterator through each grid on board
-  for (int i = 0; i < Game::BOARD_SIZE; i++) {
-    for (int j = 0; j < Game::BOARD_SIZE; j++) {
-      // if current grid is empty and
-      // its neighbor within search range is occupied
-      if (board[i][j] == Stone::EMPTY && IsValidPosition(board, i, j)) {
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SetThreadNum(int threads) {
+  StopSearch();
+  thread_num = threads;
+  thread_pool.reset();
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SetRandomSeed(unsigned seed) {
+  StopSearch();
+  root_random.seed(seed);
+}
+
+template <int N, int K>
+SearchStatistics BasicAlphaBetaAlgorithm<N, K>::GetStatistics() const {
+  SearchStatistics statistics{};
+  statistics.tt_hits = transposition_table.GetHits();
+  statistics.tt_misses = transposition_table.GetMisses();
+  statistics.nodes = node_count.load();
+  statistics.completed_depth = completed_depth;
+  statistics.best_value = best_value;
+  statistics.winning_move = winning_move;
+  statistics.forced_move = forced_move;
+  statistics.threat_nodes = threat_nodes;
+  statistics.book_move = book_move;
+  statistics.ponder_hit = ponder_hit;
+  statistics.reduced_moves = reduced_moves.load();
+  statistics.reduction_failures = reduction_failures.load();
+  statistics.futility_prunes = futility_prunes.load();
+  statistics.quiescence_nodes = quiescence_nodes.load();
+  return statistics;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SetSearchLimits(
+    const SearchLimits& search_limits) {
+  StopSearch();
+  limits = search_limits;
+}
+
+template <int N, int K>
+SearchLimits BasicAlphaBetaAlgorithm<N, K>::GetSearchLimits() const {
+  return limits;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SetThreatLimits(
+    const ThreatLimits& limits) {
+  StopSearch();
+  threat_limits = limits;
+}
+
+template <int N, int K>
+ThreatLimits BasicAlphaBetaAlgorithm<N, K>::GetThreatLimits() const {
+  return threat_limits;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SetThreatProbe(bool enabled) {
+  StopSearch();
+  threat_probe = enabled;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SetMoveOrdering(bool enabled) {
+  StopSearch();
+  move_ordering = enabled;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SetPrincipalVariationSearch(bool enabled) {
+  StopSearch();
+  principal_variation = enabled;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SetPruningOptions(
+    const PruningOptions& options) {
+  StopSearch();
+  pruning = options;
+}
+
+template <int N, int K>
+PruningOptions BasicAlphaBetaAlgorithm<N, K>::GetPruningOptions() const {
+  return pruning;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::InitScoreTable() {
+  // score of each pattern type, used to score lines by their type
+  memset(type_score, 0, sizeof(type_score));
+  for (auto& i : PATTERNS)
+    if (i.type <= HALF_OPEN_TWO) type_score[i.type] = i.score;
+  // a point value is either a pattern score, a combination score or 0
+  int levels[PATTERN_NUM + 6];
+  int level_num = 0;
+  for (auto& i : PATTERNS) levels[level_num++] = i.score;
+  levels[level_num++] = DOUBLE_FOUR_SCORE;
+  levels[level_num++] = DOUBLE_THREE_SCORE;
+  levels[level_num++] = THREE_HALF_THREE_SCORE;
+  levels[level_num++] = DOUBLE_TWO_SCORE;
+  levels[level_num++] = TWO_HALF_TWO_SCORE;
+  levels[level_num++] = 0;
+  // keep distinct values from highest to lowest
+  std::sort(levels, levels + level_num, std::greater<int>());
+  int* levels_end = std::unique(levels, levels + level_num);
+  level_num = static_cast<int>(levels_end - levels);
+  assert(level_num <= SCORE_BUCKET_NUM);
+  score_level_num = std::min(level_num, SCORE_BUCKET_NUM);
+  std::copy(levels, levels + score_level_num, score_levels);
+}
+
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::GetScoreBucket(int value) const {
+  // the first level not greater than the value
+  int bucket = 0;
+  while (bucket < score_level_num - 1 && score_levels[bucket] > value) bucket++;
+  return bucket;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SearchCandidatePosition(
+    SearchPosition& position, Stone player, CandidateList& candidates) {
+  Stone(*board)[N] = position.board;
+  // candidates in generation order with the bucket of their value
+  // and their order among grids of the same value
+  CandidatePosition generated[N * N];
+  int buckets[N * N];
+  int orders[N * N];
+  int bucket_size[SCORE_BUCKET_NUM] = {};
+  int count = 0;
+  const int* killers = move_ordering && position.ply < MAX_SEARCH_PLY
+                          ? position.killers[position.ply]
+                          : nullptr;
+  const std::atomic<int>(*player_history)[N] = history[player - 1];
+  // iterator through each candidate grid, that is an empty grid
+  // whose neighbor within search range is occupied
+  for (int i = 0; i < N; i++) {
+    uint32_t row = position.candidates.GetRow(i);
+    for (int j = 0; row != 0 && j < N; j++) {
+      if ((row >> static_cast<unsigned>(j)) & 1U) {
         // temporarily place player stone
         board[i][j] = player;
         // calculate the score of current position
         int value = ScorePoint(board, player, i, j);
         // reset current grid back to empty
         board[i][j] = Stone::EMPTY;
-        //  code below perform doubly linked list sort
-        // ==========================================================
-        // create a new node of candidate position
-        auto* pnew = new CandidatePosition(i, j, value);
-        // if the doubly linked list is empty, set current node to head
-        if (pRoot == nullptr)
-          pRoot = pnew;
-        else {
-          CandidatePosition* p = pRoot;
-          while (true) {
-            // if current node is greater than new node
-            if (p->grid_value > value) {
-              // if has next node, then walk to next node
-              if (p->pNext != nullptr) p = p->pNext;
-              // otherwise append to tail
-              else {
-                p->pNext = pnew;
-                pnew->pPrev = p;
-                break;
-              }
-            } else {
-              // otherwise it means new node is greater than current
-              // if current is head, append new node to head
-              if (p->pPrev != nullptr) {
-                p->pPrev->pNext = pnew;
-                pnew->pPrev = p->pPrev;
-                pnew->pNext = p;
-                p->pPrev = pnew;
-                break;
-              } else {
-                // otherwise insert new node in front of current node
-                pnew->pPrev = nullptr;
-                pnew->pNext = p;
-                p->pPrev = pnew;
-                pRoot = pnew;
-                break;
-              }
-            }
-          }
-        }
-        // ==========================================================
+        generated[count] = {i, j, value};
+        buckets[count] = GetScoreBucket(value);
+        // killer moves rank above every history score
+        orders[count] =
+            move_ordering
+                ? player_history[i][j].load(std::memory_order_relaxed)
+                : 0;
+        for (int k = 0; killers && k < KILLER_NUM; k++)
+          if (killers[k] == i * N + j)
+            orders[count] = HISTORY_MAX + KILLER_NUM - k;
+        bucket_size[buckets[count]]++;
+        count++;
+      }
+    }
+  }
+  // first index of every bucket in the sorted list
+  int bucket_start[SCORE_BUCKET_NUM];
+  int start = 0;
+  for (int b = 0; b < SCORE_BUCKET_NUM; b++) {
+    bucket_start[b] = start;
+    start += bucket_size[b];
+  }
+  // grids of equal value are searched from the last generated one
+  int sorted_orders[N * N];
+  for (int k = count - 1; k >= 0; k--) {
+    int index = bucket_start[buckets[k]]++;
+    candidates.positions[index] = generated[k];
+    sorted_orders[index] = orders[k];
+  }
+  candidates.size = count;
+  // insertion sort every bucket by order, equal ones keep their place
+  start = 0;
+  for (int b = 0; b < SCORE_BUCKET_NUM; b++) {
+    int end = start + bucket_size[b];
+    for (int k = start + 1; k < end; k++) {
+      CandidatePosition candidate = candidates.positions[k];
+      int order = sorted_orders[k];
+      int n = k;
+      for (; n > start && sorted_orders[n - 1] < order; n--) {
+        candidates.positions[n] = candidates.positions[n - 1];
+        sorted_orders[n] = sorted_orders[n - 1];
       }
+      candidates.positions[n] = candidate;
+      sorted_orders[n] = order;
     }
+    start = end;
   }
+}
 
-  return pRoot;
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::MoveToFront(CandidateList& candidates,
+                                                int x, int y) {
+  CandidatePosition* first = candidates.positions;
+  CandidatePosition* last = candidates.positions + candidates.size;
+  // find the position with given coordinate
+  CandidatePosition* p = std::find_if(
+      first, last, [x, y](const CandidatePosition& candidate) {
+        return candidate.row_index == x && candidate.column_index == y;
+      });
+  // if not found or already the head, nothing need to be changed
+  if (p == last || p == first) return;
+  // shift the positions in front of it back by one
+  std::rotate(first, p, p + 1);
 }
 
-int AlphaBetaAlgorithm::MinMax(Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE],
-                               int depth, Stone maxPlayer, Stone player,
-                               int alpha, int beta) {
-  // if reach terminal state, return board state score
-  if (depth == 0 || GetWinner(board) != 0) {
-    return EvaluateMinMax(board, maxPlayer);
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::MinMax(SearchPosition& position, int depth,
+                                          Stone player, int alpha, int beta,
+                                          SplitPoint* split) {
+  // pending threats are played out before the leaf is evaluated, the
+  // leaf is counted there
+  if (depth == 0 && position.winner == Stone::EMPTY) {
+    int budget = QUIESCENCE_NODE_LIMIT;
+    return Quiescence(position, player, alpha, beta, limits.quiescence_depth,
+                      budget, split);
   }
-  if (player == maxPlayer) {
-    int bestValue = std::numeric_limits<int>::min();
-    // perform sort for candidate position based on point value
-    CandidatePosition* pRoot = SearchCandidatePosition(board, player);
-    CandidatePosition* pNext = pRoot;
-    // walk through doubly linked list to find best point within depth search
-    while (pNext) {
-      // retrieve x and y coordinate from current candidate position
-      int x = pNext->row_index;
-      int y = pNext->column_index;
-      // temporarily place player stone
-      board[x][y] = player;
-      // perform minimax recursion to find global point value
-      int value = MinMax(board, depth - 1, maxPlayer,
-                         (player == Stone::BLACK) ? Stone::WHITE : Stone::BLACK,
-                         alpha, beta);
-      // reset current grid back to empty
-      board[x][y] = Stone::EMPTY;
-      // update alpha to current best value
-      bestValue = max(bestValue, value);
-      alpha = max(alpha, bestValue);
-      // perform beta pruning
-      if (beta <= alpha)
-        // since candidate position is sorted, this means the rest
-        // of the point must have lower score and thus can be halted
-        break;
-      // walk to next candidate node
-      pNext = pNext->pNext;
+  // once the budget runs out, the result is discarded by the root.
+  // after a cutoff, the result is discarded by the split point
+  if (IsSearchStopped() || (split && split->IsCutoff())) return 0;
+  // symmetric positions share an entry, its move is stored on the
+  // canonical board. Score is relative to the player to move, so the key
+  // only marks it
+  int symmetry;
+  uint64_t key = position.hash.Canonical(symmetry) ^ Zobrist::TurnKey(player);
+  // if reach terminal state, return board state score. Score caches are
+  // up to date, evaluation is cheaper than a transposition table probe
+  if (position.winner != Stone::EMPTY)
+    return EvaluateMinMax(position, player);
+  // look up transposition table, use stored score if deep enough
+  int original_alpha = alpha;
+  int original_beta = beta;
+  int hash_x = -1, hash_y = -1;
+  TranspositionEntry entry{};
+  if (transposition_table.Probe(key, entry)) {
+    if (entry.row_index >= 0)
+      Zobrist::InverseTransform(symmetry, entry.row_index, entry.column_index,
+                                hash_x, hash_y);
+    if (entry.depth >= depth) {
+      if (entry.bound == EXACT) return entry.score;
+      if (entry.bound == LOWER_BOUND) alpha = max(alpha, entry.score);
+      if (entry.bound == UPPER_BOUND) beta = min(beta, entry.score);
+      if (beta <= alpha) return entry.score;
     }
-    // delete the doubly linked list
-    pNext = pRoot;
-    while (pNext) {
-      CandidatePosition* ptemp = pNext->pNext;
-      delete pNext;
-      pNext = ptemp;
+  }
+  Stone opponent = (player == Stone::BLACK) ? Stone::WHITE : Stone::BLACK;
+  int bestX = -1, bestY = -1;
+  int bestValue = -SCORE_INFINITY;
+  // quiet moves matter little unless the opponent has a three or four to
+  // answer
+  bool threatened = HasThreat(player == Stone::BLACK
+                                  ? &position.white_score_cache
+                                  : &position.black_score_cache);
+  // near the leaves, a quiet move changes the static score by less than
+  // the margin
+  bool futile = pruning.futility_pruning && depth <= pruning.futility_depth &&
+                !threatened;
+  int static_value = futile ? EvaluateMinMax(position, player) : 0;
+  // the player to move is above beta before moving. A quiet answer of the
+  // opponent takes back no more than the move gains
+  if (futile && static_value >= beta) {
+    futility_prunes.fetch_add(1, std::memory_order_relaxed);
+    return static_value;
+  }
+  int futility_value = static_value + pruning.futility_margin;
+  // perform sort for candidate position based on point value
+  CandidateList candidates;
+  SearchCandidatePosition(position, player, candidates);
+  // every empty grid is near a stone, so the board is full. It is a draw
+  if (candidates.size == 0) return 0;
+  // search best move of stored position first
+  if (hash_x >= 0) MoveToFront(candidates, hash_x, hash_y);
+  // walk through sorted list to find best point within depth search
+  for (int k = 0; k < candidates.size; k++) {
+    const CandidatePosition& candidate = candidates.positions[k];
+    // retrieve x and y coordinate from current candidate position
+    int x = candidate.row_index;
+    int y = candidate.column_index;
+    bool quiet = candidate.grid_value < type_score[OPEN_THREE];
+    // a quiet move can not reach alpha, its score is at most the margin
+    // above the static score
+    if (futile && k > 0 && quiet && futility_value <= alpha) {
+      futility_prunes.fetch_add(1, std::memory_order_relaxed);
+      bestValue = max(bestValue, futility_value);
+      continue;
+    }
+    int reduction = GetReduction(candidate, k, depth, threatened);
+    if (reduction > 0) reduced_moves.fetch_add(1, std::memory_order_relaxed);
+    // temporarily place player stone
+    MoveUndo undo;
+    MakeMove(position, x, y, player, undo);
+    // the first child is expected to be the best, the rest only have to
+    // be proven worse
+    int value = SearchChild(position, depth - 1, opponent, alpha, beta,
+                            k == 0, reduction, split);
+    // reset current grid back to empty
+    UnmakeMove(position, x, y, undo);
+    // stop walking once the budget runs out
+    if (IsSearchCancelled(split)) break;
+    // update alpha to current best value
+    if (value > bestValue) {
+      bestValue = value;
+      bestX = x;
+      bestY = y;
+    }
+    alpha = max(alpha, bestValue);
+    // perform beta pruning
+    if (beta <= alpha) {
+      // since candidate position is sorted, this means the rest
+      // of the point must have lower score and thus can be halted
+      RecordCutoff(position, player, x, y, depth);
+      break;
     }
-    return bestValue;
+    // first child is searched, share the rest with idle workers
+    if (k + 1 < candidates.size && split_search && depth >= SPLIT_MIN_DEPTH) {
+      SearchSplitPoint(position, depth, player, alpha, beta, split,
+                       candidates, k + 1, threatened, bestValue, bestX,
+                       bestY);
+      break;
+    }
+  }
+  // interrupted search is incomplete, do not save it
+  if (IsSearchCancelled(split)) return bestValue;
+  // store the result, the bound depends on the window it is searched with
+  BoundType bound = EXACT;
+  if (bestValue <= original_alpha)
+    bound = UPPER_BOUND;
+  else if (bestValue >= original_beta)
+    bound = LOWER_BOUND;
+  if (bestX >= 0) Zobrist::Transform(symmetry, bestX, bestY, bestX, bestY);
+  transposition_table.Store(key, depth, bound, bestValue, bestX, bestY);
+  return bestValue;
+}
+
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::Quiescence(SearchPosition& position,
+                                              Stone player, int alpha, int beta,
+                                              int depth, int& budget,
+                                              SplitPoint* split) {
+  if (IsSearchStopped() || (split && split->IsCutoff())) return 0;
+  quiescence_nodes.fetch_add(1, std::memory_order_relaxed);
+  budget--;
+  if (position.winner != Stone::EMPTY)
+    return EvaluateMinMax(position, player);
+  // forcing sequences reach the same position in many orders. Any stored
+  // score is used, an entry of the full search is deeper than this one
+  int symmetry;
+  uint64_t key = position.hash.Canonical(symmetry) ^ Zobrist::TurnKey(player);
+  int original_alpha = alpha;
+  int original_beta = beta;
+  int hash_x = -1, hash_y = -1;
+  TranspositionEntry entry{};
+  bool found = transposition_table.Probe(key, entry);
+  if (found) {
+    if (entry.row_index >= 0)
+      Zobrist::InverseTransform(symmetry, entry.row_index, entry.column_index,
+                                hash_x, hash_y);
+    if (entry.bound == EXACT) return entry.score;
+    if (entry.bound == LOWER_BOUND) alpha = max(alpha, entry.score);
+    if (entry.bound == UPPER_BOUND) beta = min(beta, entry.score);
+    if (beta <= alpha) return entry.score;
+  }
+  // once the budget is spent, the remaining nodes are only evaluated
+  if (budget < 0) return EvaluateMinMax(position, player);
+  Stone opponent = (player == Stone::BLACK) ? Stone::WHITE : Stone::BLACK;
+  typename ThreatSolver::ThreatGrids own;
+  ThreatSolver::FindThreats(position.bitboard, player, own);
+  // player to move completes five
+  if (own.five_num > 0) return THREAT_WIN_SCORE;
+  // a quiet looking position may be lost to a short forced sequence
+  int threat_bonus = threat_probe ? ProbeLeafThreats(position, player) : 0;
+  if (threat_bonus >= THREAT_WIN_SCORE) return THREAT_WIN_SCORE;
+  int stand_pat = EvaluateMinMax(position, player) + threat_bonus;
+  if (depth <= 0) return stand_pat;
+  typename ThreatSolver::ThreatGrids threats;
+  ThreatSolver::FindThreats(position.bitboard, opponent, threats);
+  // two grids completing five can not both be blocked
+  if (threats.five_num >= 2) return -THREAT_WIN_SCORE;
+  // forcing moves, x * BOARD_SIZE + y each. A grid making a four for
+  // the player and blocking a three is listed once
+  int moves[N * N];
+  bool listed[N * N] = {};
+  int move_num = 0;
+  int bestValue = -SCORE_INFINITY;
+  if (threats.five_num == 1) {
+    // the only move that does not lose is blocking the four
+    moves[move_num++] = threats.fives[0];
   } else {
-    int bestValue = std::numeric_limits<int>::max();
-    // perform sort for candidate position based on point value
-    CandidatePosition* pRoot = SearchCandidatePosition(board, player);
-    CandidatePosition* pNext = pRoot;
-    // walk through doubly linked list to find best point within depth search
-    while (pNext) {
-      // retrieve x and y coordinate from current candidate position
-      int x = pNext->row_index;
-      int y = pNext->column_index;
-      // temporarily place player stone
-      board[x][y] = player;
-      // perform minimax recursion to find global point value
-      int value = MinMax(board, depth - 1, maxPlayer,
-                         (player == Stone::BLACK) ? Stone::WHITE : Stone::BLACK,
-                         alpha, beta);
-      // reset current grid back to empty
-      board[x][y] = Stone::EMPTY;
-      // update beta to current best value
-      bestValue = min(bestValue, value);
-      beta = min(beta, bestValue);
-      // perform alpha pruning
-      if (beta <= alpha)
-        // since candidate position is sorted, this means the rest
-        // of the point must have lower score and thus can be halted
-        break;
-      // walk to next candidate node
-      pNext = pNext->pNext;
+    // an open three becomes an open four unless a grid of its window is
+    // taken, or a four gains a tempo
+    move_num = ThreatSolver::FindThreeBlocks(position.bitboard, opponent,
+                                             moves);
+    for (int k = 0; k < move_num; k++) listed[moves[k]] = true;
+    if (move_num == 0) {
+      // nothing to answer, the player may keep the static score
+      if (stand_pat >= beta) return stand_pat;
+      alpha = max(alpha, stand_pat);
+      bestValue = stand_pat;
     }
-    // delete the doubly linked list
-    pNext = pRoot;
-    while (pNext) {
-      CandidatePosition* ptemp = pNext->pNext;
-      delete pNext;
-      pNext = ptemp;
+    for (int k = 0; k < own.four_num; k++)
+      if (!listed[own.fours[k]]) moves[move_num++] = own.fours[k];
+  }
+  // a loss is only claimed once the threat is read out. Without a block
+  // or a four to search the static score is all that is known
+  if (move_num == 0) return stand_pat;
+  // search the stored move first
+  if (hash_x >= 0) {
+    int* first = moves;
+    int* last = moves + move_num;
+    int* p = std::find(first, last, hash_x * N + hash_y);
+    if (p != last) std::rotate(first, p, p + 1);
+  }
+  int bestX = -1, bestY = -1;
+  for (int k = 0; k < move_num; k++) {
+    // once the budget is spent, the moves searched so far decide
+    if (k > 0 && budget <= 0) break;
+    int x = moves[k] / N;
+    int y = moves[k] % N;
+    MoveUndo undo;
+    MakeMove(position, x, y, player, undo);
+    int value = -Quiescence(position, opponent, -beta, -alpha, depth - 1,
+                            budget, split);
+    UnmakeMove(position, x, y, undo);
+    if (IsSearchCancelled(split)) return bestValue;
+    if (value > bestValue) {
+      bestValue = value;
+      bestX = x;
+      bestY = y;
     }
-    return bestValue;
+    alpha = max(alpha, bestValue);
+    if (beta <= alpha) break;
   }
+  // plies of forcing moves left are not recorded, the entry is stored at
+  // depth 0 and never replaces a result of the full search
+  if (found && entry.depth > 0) return bestValue;
+  BoundType bound = EXACT;
+  if (bestValue <= original_alpha)
+    bound = UPPER_BOUND;
+  else if (bestValue >= original_beta)
+    bound = LOWER_BOUND;
+  if (bestX >= 0) Zobrist::Transform(symmetry, bestX, bestY, bestX, bestY);
+  transposition_table.Store(key, 0, bound, bestValue, bestX, bestY);
+  return bestValue;
 }
 
-int AlphaBetaAlgorithm::AlphaBetaGo(
-    Stone chess[Game::BOARD_SIZE][Game::BOARD_SIZE], Stone player, int& x,
-    int& y) {
-  // check if it's the first stone in the game
-  bool is_first = true;
-  for (int i = 0; i < Game::BOARD_SIZE; i++) {
-    for (int j = 0; j < Game::BOARD_SIZE; j++)
-      if (chess[i][j] != Stone::EMPTY) {
-        is_first = false;
-        break;
-      }
-    if (!is_first) break;
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::SearchChild(SearchPosition& position,
+                                               int depth, Stone player,
+                                               int alpha, int beta,
+                                               bool full_window, int reduction,
+                                               SplitPoint* split) {
+  if (full_window || !principal_variation)
+    return -MinMax(position, depth, player, -beta, -alpha, split);
+  // a shallower probe failing low is trusted
+  if (reduction > 0) {
+    int value = -MinMax(position, depth - reduction, player, -alpha - 1,
+                        -alpha, split);
+    if (value <= alpha || IsSearchCancelled(split)) return value;
+    reduction_failures.fetch_add(1, std::memory_order_relaxed);
   }
-  // if yes, place the stone in the middle of the board
-  if (is_first) {
-    x = (int)(Game::BOARD_SIZE / 2);
-    y = (int)(Game::BOARD_SIZE / 2);
-    return 1;
+  // a null window only tells whether the child beats alpha
+  int value = -MinMax(position, depth, player, -alpha - 1, -alpha, split);
+  // it does, search again for the exact score
+  if (value > alpha && value < beta && !IsSearchCancelled(split))
+    value = -MinMax(position, depth, player, -beta, -alpha, split);
+  return value;
+}
+
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::GetReduction(
+    const CandidatePosition& candidate, int index, int depth,
+    bool threatened) const {
+  // a reduced move is probed with a null window
+  if (!pruning.late_move_reduction || !principal_variation || threatened ||
+      depth < pruning.lmr_min_depth || index < pruning.lmr_full_moves ||
+      candidate.grid_value >= type_score[OPEN_THREE])
+    return 0;
+  int reduction = index >= pruning.lmr_deep_moves ? pruning.lmr_deep_reduction
+                                                  : pruning.lmr_reduction;
+  // the child is searched at least to depth 0
+  return max(min(reduction, depth - 1), 0);
+}
+
+template <int N, int K>
+bool BasicAlphaBetaAlgorithm<N, K>::HasThreat(const ScoreCache* cache) {
+  for (int dir = 0; dir < 4; dir++)
+    for (int type = CONSECUTIVE_FIVE; type <= OPEN_THREE; type++)
+      if (cache->type_count[dir][type] > 0) return true;
+  return false;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SearchSplitPoint(
+    SearchPosition& position, int depth, Stone player, int& alpha, int& beta,
+    SplitPoint* parent, const CandidateList& candidates, int first,
+    bool threatened, int& bestValue, int& bestX, int& bestY) {
+  ThreadPool& pool = GetThreadPool();
+  SplitPoint split;
+  split.parent = parent;
+  split.cutoff.store(false);
+  split.alpha = alpha;
+  split.beta = beta;
+  split.bestValue = bestValue;
+  split.bestX = bestX;
+  split.bestY = bestY;
+  SplitWork work;
+  work.split = &split;
+  work.position = &position;
+  work.candidates = &candidates;
+  work.next.store(first);
+  work.depth = depth;
+  work.player = player;
+  work.threatened = threatened;
+  memcpy(work.killers, position.killers, sizeof(work.killers));
+  // one task per worker is enough, each takes siblings until none is left.
+  // The task only holds two pointers, so it is queued without allocation
+  int task_num = min(pool.GetThreadNum(), candidates.size - first);
+  TaskGroup group;
+  for (int k = 0; k < task_num; k++)
+    pool.Submit(group, [this, &work] { SearchSplitSiblings(work); });
+  // the owner of the split point helps searching while it waits
+  pool.Wait(group);
+  alpha = split.alpha;
+  beta = split.beta;
+  bestValue = split.bestValue;
+  bestX = split.bestX;
+  bestY = split.bestY;
+  // siblings searched on other threads teach the node their killers
+  memcpy(position.killers, work.killers, sizeof(work.killers));
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SearchSplitSiblings(SplitWork& work) {
+  SplitPoint& split = *work.split;
+  // siblings may all be taken or cut off while the task was queued
+  if (IsSearchCancelled(&split) ||
+      work.next.load() >= work.candidates->size)
+    return;
+  SplitStack& stack = GetSplitStack();
+  if (stack.size == stack.positions.size())
+    stack.positions.emplace_back(new SearchPosition());
+  SearchPosition& position = *stack.positions[stack.size];
+  stack.size++;
+  position = *work.position;
+  Stone player = work.player;
+  Stone opponent = (player == Stone::BLACK) ? Stone::WHITE : Stone::BLACK;
+  while (!IsSearchCancelled(&split)) {
+    int k = work.next.fetch_add(1);
+    if (k >= work.candidates->size) break;
+    const CandidatePosition& candidate = work.candidates->positions[k];
+    int x = candidate.row_index;
+    int y = candidate.column_index;
+    // late siblings are reduced as in the sequential loop
+    int reduction = GetReduction(candidate, k, work.depth, work.threatened);
+    if (reduction > 0) reduced_moves.fetch_add(1, std::memory_order_relaxed);
+    // start with the window narrowed by finished siblings
+    int siblingAlpha, siblingBeta;
+    {
+      std::lock_guard<std::mutex> lock(split.lock);
+      siblingAlpha = split.alpha;
+      siblingBeta = split.beta;
+    }
+    MoveUndo undo;
+    MakeMove(position, x, y, player, undo);
+    // siblings come after the first child, probe them first
+    int value = SearchChild(position, work.depth - 1, opponent, siblingAlpha,
+                            siblingBeta, false, reduction, &split);
+    UnmakeMove(position, x, y, undo);
+    // result of a cancelled sibling is incomplete
+    if (IsSearchCancelled(&split)) break;
+    std::lock_guard<std::mutex> lock(split.lock);
+    if (value > split.bestValue) {
+      split.bestValue = value;
+      split.bestX = x;
+      split.bestY = y;
+    }
+    split.alpha = max(split.alpha, split.bestValue);
+    // remaining siblings can not change the result of the node
+    if (split.beta <= split.alpha && !split.cutoff.load()) {
+      RecordCutoff(position, player, x, y, work.depth);
+      split.cutoff.store(true);
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(split.lock);
+    MergeKillers(position.killers, work.killers, position.ply);
   }
-  // reset backup chess board.
-  memcpy(board_backup, chess,
-         Game::BOARD_SIZE * Game::BOARD_SIZE * sizeof(int));
+  stack.size--;
+}
+
+template <int N, int K>
+typename BasicAlphaBetaAlgorithm<N, K>::SplitStack&
+BasicAlphaBetaAlgorithm<N, K>::GetSplitStack() {
+  static thread_local SplitStack stack;
+  return stack;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::MergeKillers(
+    const int from[MAX_SEARCH_PLY][KILLER_NUM],
+    int to[MAX_SEARCH_PLY][KILLER_NUM], int first_ply) {
+  for (int ply = first_ply; ply < MAX_SEARCH_PLY; ply++) {
+    // add the older moves first, so that the latest ends up in front
+    for (int i = KILLER_NUM - 1; i >= 0; i--) {
+      int move = from[ply][i];
+      if (move < 0 || std::find(to[ply], to[ply] + KILLER_NUM, move) !=
+                          to[ply] + KILLER_NUM)
+        continue;
+      for (int k = KILLER_NUM - 1; k > 0; k--) to[ply][k] = to[ply][k - 1];
+      to[ply][0] = move;
+    }
+  }
+}
+
+template <int N, int K>
+std::vector<RootMove> BasicAlphaBetaAlgorithm<N, K>::GenerateRootMoves(
+    SearchPosition& position, Stone player, std::mt19937& random) {
+  std::vector<RootMove> moves;
+  // reuse candidate search, it is already sorted by point value
+  CandidateList candidates;
+  SearchCandidatePosition(position, player, candidates);
+  // moves leading to symmetric boards are the same move, e.g. the eight
+  // answers around a single stone are only two. Keep the first of them,
+  // they have the same point value
+  std::vector<uint64_t> children;
+  std::vector<int> values;
+  for (int k = 0; k < candidates.size; k++) {
+    const CandidatePosition& candidate = candidates.positions[k];
+    SymmetricHash child = position.hash;
+    child.Toggle(candidate.row_index, candidate.column_index, player);
+    int symmetry;
+    uint64_t key = child.Canonical(symmetry);
+    if (std::find(children.begin(), children.end(), key) != children.end())
+      continue;
+    children.push_back(key);
+    values.push_back(candidate.grid_value);
+    moves.push_back({candidate.row_index, candidate.column_index,
+                     std::numeric_limits<int>::min()});
+  }
+  // shuffle every run of equal point value
+  int size = static_cast<int>(moves.size());
+  for (int first = 0, last = 0; first < size; first = last) {
+    while (last < size && values[last] == values[first]) last++;
+    std::shuffle(moves.begin() + first, moves.begin() + last, random);
+  }
+  return moves;
+}
+
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::FinishIteration(std::vector<RootMove>& moves,
+                                                   int& x, int& y) {
+  int bestValue = std::numeric_limits<int>::min();
+  for (auto& move : moves) {
+    // if current grid value is greater than max
+    if (move.value > bestValue) {
+      bestValue = move.value;
+      x = move.row_index;
+      y = move.column_index;
+    }
+  }
+  // search best move of this iteration first in next iteration,
+  // the rest keep their relative order
+  std::stable_sort(moves.begin(), moves.end(),
+                   [](const RootMove& a, const RootMove& b) {
+                     return a.value > b.value;
+                   });
+  for (size_t i = 0; i < moves.size(); i++) {
+    if (moves[i].row_index == x && moves[i].column_index == y) {
+      std::rotate(moves.begin(), moves.begin() + i, moves.begin() + i + 1);
+      break;
+    }
+  }
+  return bestValue;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::RecordCutoff(SearchPosition& position,
+                                                 Stone player, int x, int y,
+                                                 int depth) {
+  // keep the latest distinct cutoff moves of the ply
+  if (position.ply < MAX_SEARCH_PLY) {
+    int* killers = position.killers[position.ply];
+    int move = x * N + y;
+    if (killers[0] != move) {
+      for (int k = KILLER_NUM - 1; k > 0; k--) killers[k] = killers[k - 1];
+      killers[0] = move;
+    }
+  }
+  // deeper cutoffs save more nodes, lost updates of racing threads
+  // only make the score slightly lower
+  std::atomic<int>& score = history[player - 1][x][y];
+  int value = score.load(std::memory_order_relaxed) + depth * depth;
+  score.store(min(value, HISTORY_MAX), std::memory_order_relaxed);
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::AgeHistory() {
+  for (auto& color : history)
+    for (auto& row : color)
+      for (auto& grid : row)
+        grid.store(grid.load(std::memory_order_relaxed) / 2,
+                   std::memory_order_relaxed);
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::ResetStatistics() {
+  node_count.store(0);
+  completed_depth = 0;
+  best_value = 0;
+  winning_move = false;
+  forced_move = false;
+  threat_nodes = 0;
+  book_move = false;
+  reduced_moves.store(0);
+  reduction_failures.store(0);
+  futility_prunes.store(0);
+  quiescence_nodes.store(0);
+}
+
+template <int N, int K>
+bool BasicAlphaBetaAlgorithm<N, K>::IsSearchCancelled(
+    const SplitPoint* split) const {
+  if (stop_search.load(std::memory_order_relaxed)) return true;
+  return split && split->IsCutoff();
+}
+
+template <int N, int K>
+bool BasicAlphaBetaAlgorithm<N, K>::IsSearchStopped() {
+  if (stop_search.load(std::memory_order_relaxed)) return true;
+  long long nodes = node_count.fetch_add(1, std::memory_order_relaxed) + 1;
+  // reading the clock is slow, only check it once in a while
+  if (nodes % DEADLINE_CHECK_INTERVAL != 0) return false;
+  if (limits.node_limit > 0 && nodes >= limits.node_limit) {
+    stop_search.store(true, std::memory_order_relaxed);
+    return true;
+  }
+  // no deadline while pondering, it is set once the reply is played
+  std::chrono::steady_clock::rep deadline =
+      search_deadline.load(std::memory_order_relaxed);
+  if (deadline > 0 &&
+      std::chrono::steady_clock::now().time_since_epoch().count() >=
+          deadline) {
+    stop_search.store(true, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::InitRootPosition(Stone board[N][N]) {
+  memcpy(root_position.board, board, N * N * sizeof(int));
+  root_position.bitboard = BitBoard(board);
+  root_position.candidates.Init(board, SEARCH_RANGE);
+  root_position.hash.Init(board);
   // calculate score for current board state
   // minimax just need to update score for attempt grid, much more efficient
-  ScoreChessToCache(chess, Stone::BLACK, &black_score_cache);
-  ScoreChessToCache(chess, Stone::WHITE, &white_score_cache);
-  // using alpha-beta pruning to find best place to place stone
-  int bestX = -1;
-  int bestY = -1;
-  int bestValue = std::numeric_limits<int>::min();
-  // go through each grid on the board
-  for (int i = 0; i < Game::BOARD_SIZE; i++) {
-    for (int j = 0; j < Game::BOARD_SIZE; j++) {
-      // if current grid is empty and its neighbor is within 2 grid range
-      if (chess[i][j] == Stone::EMPTY && IsValidPosition(chess, i, j)) {
-        // temporarily place player stone in current grid
-        chess[i][j] = player;
-        // using minimax to simulate play and find score of this grid
-        int value = MinMax(
-            chess, SEARCH_DEPTH, player,
-            (player == Stone::BLACK) ? Stone::WHITE : Stone::BLACK,
-            std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
-        // reset current grid back to empty
-        chess[i][j] = Stone::EMPTY;
-        // if current grid value is greater than max
-        // or equal to current value (using 30% random disturbance)
-        if (value > bestValue ||
-            (value == bestValue && rand() % 100 < 30)) {  // NOLINT
-          // update current best value and corresponding x and y coordinate
-          bestValue = value;
-          bestX = i;
-          bestY = j;
-        }
-      }
+  ScoreChessToCache(board, &root_position.black_score_cache,
+                    &root_position.white_score_cache);
+  // move leading to this board is unknown, scan the whole board once
+  root_position.last_x = -1;
+  root_position.last_y = -1;
+  root_position.winner = static_cast<Stone>(GetWinner(board));
+  root_position.ply = 0;
+  for (auto& ply : root_position.killers)
+    for (int& killer : ply) killer = -1;
+}
+
+template <int N, int K>
+bool BasicAlphaBetaAlgorithm<N, K>::FindWinningMove(
+    SearchPosition& position, Stone player, const std::vector<RootMove>& moves,
+    int& x, int& y) {
+  for (auto& move : moves) {
+    MoveUndo undo;
+    MakeMove(position, move.row_index, move.column_index, player, undo);
+    bool win = position.winner == player;
+    if (win) best_value = EvaluateMinMax(position, player);
+    UnmakeMove(position, move.row_index, move.column_index, undo);
+    if (win) {
+      x = move.row_index;
+      y = move.column_index;
+      winning_move = true;
+      return true;
     }
   }
-  // if there's grid left then assign best value to x and y
-  if (bestX != -1 && bestY != -1) {
-    x = bestX;
-    y = bestY;
-    return 1;
+  return false;
+}
+
+template <int N, int K>
+bool BasicAlphaBetaAlgorithm<N, K>::FindForcedMove(SearchPosition& position,
+                                                   Stone player, int& x,
+                                                   int& y) {
+  Stone opponent = (player == Stone::BLACK) ? Stone::WHITE : Stone::BLACK;
+  // opponent wins next move unless the grid is blocked
+  forced_move = ThreatSolver::FindFiveMove(position.board, opponent, x, y);
+  if (!forced_move) {
+    forced_move = threat_solver.SolveVcf(position.board, player, x, y);
+    threat_nodes = threat_solver.GetNodes();
   }
-  // otherwise it means no grid is empty
-  return 0;
+  // threes take more time to read, try them after fours. A cancelled
+  // search does not wait for them
+  if (!forced_move) {
+    ThreatLimits root_limits = threat_limits;
+    root_limits.stop = &stop_search;
+    forced_move =
+        threat_solver.SolveVct(position.board, player, root_limits, x, y);
+    threat_nodes += threat_solver.GetNodes();
+  }
+  return forced_move;
 }
 
-int AlphaBetaAlgorithm::AlphaBetaGoMT(Stone (*board)[Game::BOARD_SIZE],
-                                      Stone player, int& x, int& y) {
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::GetLineIndex(int x, int y, int index[4]) {
+  index[0] = y;
+  index[1] = x;
+  index[2] = (x >= y) ? x - y : N - 1 + y - x;
+  index[3] = (x + y > N - 1) ? x + y : N - 1 - x - y;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::MakeMove(SearchPosition& position, int x,
+                                             int y, Stone player,
+                                             MoveUndo& undo) {
+  // save the lines before they are scored again
+  int index[4];
+  GetLineIndex(x, y, index);
+  ScoreCache* caches[2] = {&position.black_score_cache,
+                           &position.white_score_cache};
+  for (int c = 0; c < 2; c++) {
+    int* scores[4] = {caches[c]->horizontal_score, caches[c]->vertical_score,
+                      caches[c]->diagonal_score, caches[c]->antiDiagonal_score};
+    int* types[4] = {caches[c]->horizontal_type, caches[c]->vertical_type,
+                     caches[c]->diagonal_type, caches[c]->antiDiagonal_type};
+    for (int dir = 0; dir < 4; dir++) {
+      undo.score[c][dir] = scores[dir][index[dir]];
+      undo.type[c][dir] = types[dir][index[dir]];
+    }
+  }
+  undo.last_x = position.last_x;
+  undo.last_y = position.last_y;
+  undo.winner = position.winner;
+  position.board[x][y] = player;
+  position.bitboard.Place(x, y, player);
+  position.candidates.Place(x, y);
+  position.hash.Toggle(x, y, player);
+  position.last_x = x;
+  position.last_y = y;
+  position.ply++;
+  // only the new stone can complete five in a row
+  if (position.winner == Stone::EMPTY && position.bitboard.IsWin(x, y))
+    position.winner = player;
+  ScoreChessPointToCache(position.board, x, y, &position.black_score_cache,
+                         &position.white_score_cache);
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::UnmakeMove(SearchPosition& position, int x,
+                                               int y, const MoveUndo& undo) {
+  position.hash.Toggle(x, y, position.board[x][y]);
+  position.bitboard.Remove(x, y, position.board[x][y]);
+  position.candidates.Remove(x, y);
+  position.board[x][y] = Stone::EMPTY;
+  position.last_x = undo.last_x;
+  position.last_y = undo.last_y;
+  position.winner = undo.winner;
+  position.ply--;
+  // put saved lines back, together with their type count
+  int index[4];
+  GetLineIndex(x, y, index);
+  ScoreCache* caches[2] = {&position.black_score_cache,
+                           &position.white_score_cache};
+  for (int c = 0; c < 2; c++) {
+    int* scores[4] = {caches[c]->horizontal_score, caches[c]->vertical_score,
+                      caches[c]->diagonal_score, caches[c]->antiDiagonal_score};
+    int* types[4] = {caches[c]->horizontal_type, caches[c]->vertical_type,
+                     caches[c]->diagonal_type, caches[c]->antiDiagonal_type};
+    for (int dir = 0; dir < 4; dir++) {
+      caches[c]->type_count[dir][types[dir][index[dir]]]--;
+      scores[dir][index[dir]] = undo.score[c][dir];
+      types[dir][index[dir]] = undo.type[c][dir];
+      caches[c]->type_count[dir][undo.type[c][dir]]++;
+    }
+  }
+}
+
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::AlphaBetaGo(Stone chess[N][N], Stone player,
+                                               int& x, int& y) {
+  // a pondering search of this position goes on, any other is stopped
+  if (ContinuePondering(chess, player)) return TakeBackgroundResult(x, y);
+  BeginSearch();
+  return Search(chess, player, x, y, false);
+}
+
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::Search(Stone board[N][N], Stone player,
+                                          int& x, int& y, bool multi_thread) {
   // check if it's the first stone in the game
   bool is_first = true;
-  for (int i = 0; i < Game::BOARD_SIZE; i++) {
-    for (int j = 0; j < Game::BOARD_SIZE; j++)
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++)
       if (board[i][j] != Stone::EMPTY) {
         is_first = false;
         break;
@@ -312,399 +988,544 @@ int AlphaBetaAlgorithm::AlphaBetaGoMT(Stone (*board)[Game::BOARD_SIZE],
   }
   // if yes, place the stone in the middle of the board
   if (is_first) {
-    x = (int)(Game::BOARD_SIZE / 2);
-    y = (int)(Game::BOARD_SIZE / 2);
+    x = (int)(N / 2);
+    y = (int)(N / 2);
     return 1;
   }
-  // reset backup chess board.
-  memcpy(board_backup, board,
-         Game::BOARD_SIZE * Game::BOARD_SIZE * sizeof(int));
-  // calculate score for current board state
-  // minimax just need to update score for attempt grid, much more efficient
-  ScoreChessToCache(board, Stone::BLACK, &black_score_cache);
-  ScoreChessToCache(board, Stone::WHITE, &white_score_cache);
-  // using alpha-beta pruning to find best place to place stone
-  int bestX = -1;
-  int bestY = -1;
-  int bestValue = std::numeric_limits<int>::min();
-  // initialize thread parameter, pass game info into each thread
-  HANDLE threadHandle[THREAD_NUM] = {};
-  MinMaxThreadParam threadParam[THREAD_NUM];
-  for (auto& i : threadParam) {
-    memcpy(i.board, board, Game::BOARD_SIZE * Game::BOARD_SIZE * sizeof(int));
-    i.pAlgorithm = this;
-    i.depth = SEARCH_DEPTH;
-    i.maxPlayer = player;
-    i.player = (player == Stone::BLACK) ? Stone::WHITE : Stone::BLACK;
+  // start a new generation of transposition table entries
+  transposition_table.NewSearch();
+  transposition_table.ResetCounters();
+  AgeHistory();
+  InitRootPosition(board);
+  ResetStatistics();
+  // an opening position in the book needs no search
+  if (opening_book.Probe(root_position.hash, board, player, x, y)) {
+    book_move = true;
+    return 1;
   }
-  // go through each grid on the board
-  for (int i = 0; i < Game::BOARD_SIZE; i++) {
-    for (int j = 0; j < Game::BOARD_SIZE; j++) {
-      if (board[i][j] == 0 && IsValidPosition(board, i, j)) {
-        // the index of idle thread
-        int index = -1;
-        // iterate through each thread to find idle thread
-        for (int k = 0; k < THREAD_NUM; k++) {
-          if (threadHandle[k] == nullptr) {
-            index = k;
-            break;
-          }
-        }
-        // if there is no idle thread
-        if (index == -1) {
-          DWORD ret =
-              WaitForMultipleObjects(THREAD_NUM, threadHandle, false, INFINITE);
-          switch (ret) {
-            case WAIT_TIMEOUT:
-            case WAIT_FAILED:
-              break;
-            default:
-              // reset thread into null pointer, retrieve x and y coordinate
-              index = ret - WAIT_OBJECT_0;
-              CloseHandle(threadHandle[index]);
-              threadHandle[index] = nullptr;
-              if (threadParam[index].bestValue > bestValue ||
-                  (threadParam[index].bestValue == bestValue &&
-                   rand() % 100 < 30)) {
-                bestValue = threadParam[index].bestValue;
-                bestX = threadParam[index].x;
-                bestY = threadParam[index].y;
-              }
-              break;
-          }
-        }
-        // if there's idle thread
-        if (index >= 0) {
-          // pass coordinate that need to be simulated into this thread
-          threadParam[index].x = i;
-          threadParam[index].y = j;
-          threadHandle[index] = CreateThread(nullptr, 0, MinMaxThread,
-                                             &threadParam[index], 0, nullptr);
-        }
-      }
-    }
+  // every empty grid whose neighbor is within 2 grid range
+  std::vector<RootMove> moves =
+      GenerateRootMoves(root_position, player, root_random);
+  // otherwise it means no grid is empty
+  if (moves.empty()) return 0;
+  // fall back to the best sorted grid if not even one iteration finishes
+  int bestX = moves[0].row_index;
+  int bestY = moves[0].column_index;
+  // a move making five in a row needs no search
+  if (FindWinningMove(root_position, player, moves, x, y)) return 1;
+  // so does a move forced by threats
+  if (FindForcedMove(root_position, player, x, y)) return 1;
+  if (!multi_thread) {
+    completed_depth = SearchIterative(root_position, player, moves, 1, 0,
+                                      bestX, bestY, best_value, true);
+  } else if (parallel_mode == LAZY_SMP) {
+    SearchLazySMP(root_position, player, moves, bestX, bestY);
+  } else if (parallel_mode == SPLIT_POINT) {
+    // root moves run one by one, MinMax shares the tree with workers
+    GetThreadPool();
+    split_search = true;
+    completed_depth = SearchIterative(root_position, player, moves, 1, 0,
+                                      bestX, bestY, best_value, true);
+    split_search = false;
+  } else {
+    SearchRootSplit(root_position, player, moves, bestX, bestY);
   }
-  // retrieve result from all thread, and close each thread
-  for (int k = 0; k < THREAD_NUM; k++) {
-    if (threadHandle[k] != nullptr) {
-      WaitForSingleObject(threadHandle[k], INFINITE);
-      CloseHandle(threadHandle[k]);
-      if (threadParam[k].bestValue > bestValue ||
-          (threadParam[k].bestValue == bestValue && rand() % 100 < 30)) {
-        bestValue = threadParam[k].bestValue;
-        bestX = threadParam[k].x;
-        bestY = threadParam[k].y;
-      }
+  x = bestX;
+  y = bestY;
+  return 1;
+}
+
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::SearchIterative(SearchPosition& position,
+                                                   Stone player,
+                                                   std::vector<RootMove>& moves,
+                                                   int start_depth,
+                                                   size_t first_move, int& x,
+                                                   int& y, int& value,
+                                                   bool report_progress) {
+  int completed = 0;
+  // iterative deepening, each iteration searches one level deeper and
+  // starts from the best move of previous iteration
+  for (int depth = start_depth; depth <= limits.max_depth; depth++) {
+    // expect a score close to the previous iteration. A won or lost score
+    // can be as far out as SCORE_INFINITY, it is searched with the full
+    // window, which also keeps the window within int
+    int alpha = -SCORE_INFINITY, beta = SCORE_INFINITY;
+    if (principal_variation && completed > 0 &&
+        std::abs(value) < THREAT_WIN_SCORE) {
+      alpha = value - ASPIRATION_WINDOW;
+      beta = value + ASPIRATION_WINDOW;
+    }
+    while (true) {
+      int best = SearchRootMoves(position, player, moves, depth, first_move,
+                                 alpha, beta);
+      if (stop_search.load()) break;
+      // outside the window the score is only a bound, search again with
+      // that side open
+      if (best <= alpha && alpha > -SCORE_INFINITY)
+        alpha = -SCORE_INFINITY;
+      else if (best >= beta && beta < SCORE_INFINITY)
+        beta = SCORE_INFINITY;
+      else
+        break;
     }
+    // unfinished iteration is discarded, keep result of previous one
+    if (stop_search.load()) break;
+    value = FinishIteration(moves, x, y);
+    completed = depth;
+    if (report_progress) ReportProgress(depth, value, x, y);
   }
-  // if there's grid left then assign best value to x and y
-  if (bestX != -1 && bestY != -1) {
-    x = bestX;
-    y = bestY;
-    return 1;
+  return completed;
+}
+
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::SearchRootMoves(SearchPosition& position,
+                                                   Stone player,
+                                                   std::vector<RootMove>& moves,
+                                                   int depth, size_t first_move,
+                                                   int alpha, int beta) {
+  Stone opponent = (player == Stone::BLACK) ? Stone::WHITE : Stone::BLACK;
+  int bestValue = -SCORE_INFINITY;
+  for (size_t n = 0; n < moves.size(); n++) {
+    RootMove& move = moves[(n + first_move) % moves.size()];
+    int i = move.row_index;
+    int j = move.column_index;
+    // temporarily place player stone in current grid
+    MoveUndo undo;
+    MakeMove(position, i, j, player, undo);
+    // using minimax to simulate play and find score of this grid
+    move.value = SearchChild(position, depth, opponent, max(alpha, bestValue),
+                             beta, n == 0, 0, nullptr);
+    // reset current grid back to empty
+    UnmakeMove(position, i, j, undo);
+    if (stop_search.load()) break;
+    bestValue = max(bestValue, move.value);
+    // the window is wrong, no need to search the rest
+    if (bestValue >= beta) break;
   }
-  // otherwise it means no grid is empty
-  return 0;
+  return bestValue;
 }
 
-void AlphaBetaAlgorithm::ScoreChessPointToCache(
-    Stone chess[Game::BOARD_SIZE][Game::BOARD_SIZE], Stone player, int x, int y,
-    ScoreCache* pCache) {
-  int me = player;
-  int opponent = me == Stone::BLACK ? Stone::WHITE : Stone::BLACK;
-  // check row
-  if (true) {
-    int k = 0;           // binary number length count
-    int addr = 0;        // score table address
-    int maxValue = 0;    // current max value
-    int maxType = NONE;  // current max type
-    // go through each grid at current row
-    for (int j = 0; j < Game::BOARD_SIZE; j++) {
-      // if it's the player's stone, attach 01
-      // if it's opponent's stone, attach 11
-      // otherwise attach 00
-      addr <<= 2;  // NOLINT
-      k += 2;
-      if (chess[j][y] == me) addr |= 1;        // NOLINT
-      if (chess[j][y] == opponent) addr |= 2;  // NOLINT
-      // if binary number length reach bit data length threshold
-      // retrieve corresponding score from table
-      if (k >= BIT_DATA_LENGTH) {
-        int value = score_table[addr & BIT_DATA_SIZE];  // NOLINT
-        if (value > maxValue) {
-          // update max score
-          maxValue = value;
-          maxType = score_type_table[addr & BIT_DATA_SIZE];  // NOLINT
-        }
-      }
-    }
-    // record score for current row
-    pCache->horizontal_score[y] = maxValue;
-    pCache->horizontal_type[y] = maxType;
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::AlphaBetaGoMT(Stone (*board)[N],
+                                                 Stone player, int& x, int& y) {
+  // a pondering search of this position goes on, any other is stopped
+  if (ContinuePondering(board, player)) return TakeBackgroundResult(x, y);
+  BeginSearch();
+  return Search(board, player, x, y, true);
+}
+
+template <int N, int K>
+SearchHandle BasicAlphaBetaAlgorithm<N, K>::AlphaBetaGoAsync(
+    Stone board[N][N], Stone player, bool multi_thread) {
+  // a ponder hit hands the pondering search over to the caller
+  if (!ContinuePondering(board, player)) {
+    BeginSearch();
+    LaunchSearch(board, player, multi_thread);
   }
-  // check column
-  if (true) {
-    int k = 0;           // binary number length count
-    int addr = 0;        // score table address
-    int maxValue = 0;    // current max value
-    int maxType = NONE;  // current max type
-    for (int j = 0; j < Game::BOARD_SIZE; j++) {
-      // if it's the player's stone, append 01
-      // if it's opponent's stone, append 11
-      // otherwise append 00
-      addr <<= 2;  // NOLINT
-      k += 2;
-      if (chess[x][j] == me) addr |= 1;        // NOLINT
-      if (chess[x][j] == opponent) addr |= 2;  // NOLINT
-      // if binary number length reach bit data length threshold
-      // retrieve corresponding score from table
-      if (k >= BIT_DATA_LENGTH) {
-        int value = score_table[addr & BIT_DATA_SIZE];  // NOLINT
-        if (value > maxValue) {
-          // update max score
-          maxValue = value;
-          maxType = score_type_table[addr & BIT_DATA_SIZE];  // NOLINT
-        }
-      }
-    }
-    // record score for current column
-    pCache->vertical_score[x] = maxValue;
-    pCache->vertical_type[x] = maxType;
+  SearchHandle search;
+  search.id = background_id;
+  return search;
+}
+
+template <int N, int K>
+bool BasicAlphaBetaAlgorithm<N, K>::IsSearchReady(
+    const SearchHandle& search) const {
+  if (search.id != background_id || !background_search.valid()) return true;
+  return background_search.wait_for(std::chrono::seconds(0)) ==
+         std::future_status::ready;
+}
+
+template <int N, int K>
+SearchProgress BasicAlphaBetaAlgorithm<N, K>::GetSearchProgress(
+    const SearchHandle& search) const {
+  SearchProgress progress{};
+  progress.row_index = -1;
+  progress.column_index = -1;
+  if (search.id != background_id) return progress;
+  progress.searching = background_search.valid();
+  progress.done = IsSearchReady(search);
+  progress.pondering = pondering;
+  progress.completed_depth = progress_depth.load();
+  progress.best_value = progress_value.load();
+  int move = progress_move.load();
+  progress.row_index = move >= 0 ? move / N : -1;
+  progress.column_index = move >= 0 ? move % N : -1;
+  progress.nodes = node_count.load();
+  return progress;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SetSearchDeadline(int time_limit_ms) {
+  std::chrono::steady_clock::rep deadline = 0;
+  if (time_limit_ms > 0)
+    deadline = (std::chrono::steady_clock::now() +
+                std::chrono::milliseconds(time_limit_ms))
+                   .time_since_epoch()
+                   .count();
+  search_deadline.store(deadline);
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::CancelSearch(const SearchHandle& search) {
+  if (search.id != background_id || !background_search.valid()) return;
+  // the thread is joined by the next call that needs the engine. The
+  // threat solver and every search thread poll the flag, so that join
+  // does not wait long
+  stop_search.store(true);
+  pondering = false;
+}
+
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::TakeSearchResult(const SearchHandle& search,
+                                                    int& x, int& y) {
+  if (search.id != background_id) return 0;
+  return TakeBackgroundResult(x, y);
+}
+
+template <int N, int K>
+SearchHandle BasicAlphaBetaAlgorithm<N, K>::StartPondering(Stone board[N][N],
+                                                           Stone opponent,
+                                                           bool multi_thread) {
+  StopSearch();
+  SearchHandle search;
+  InitRootPosition(board);
+  if (root_position.winner != Stone::EMPTY) return search;
+  // the previous search stored the best reply below its best move
+  int x = -1, y = -1;
+  int symmetry;
+  uint64_t key =
+      root_position.hash.Canonical(symmetry) ^ Zobrist::TurnKey(opponent);
+  TranspositionEntry entry{};
+  if (transposition_table.Probe(key, entry) && entry.row_index >= 0)
+    Zobrist::InverseTransform(symmetry, entry.row_index, entry.column_index,
+                              x, y);
+  // otherwise expect the best sorted grid
+  if (x < 0 || board[x][y] != Stone::EMPTY) {
+    CandidateList candidates;
+    SearchCandidatePosition(root_position, opponent, candidates);
+    if (candidates.size == 0) return search;
+    x = candidates.positions[0].row_index;
+    y = candidates.positions[0].column_index;
   }
-  // check diagonal
-  if (true) {
-    int k = 0;           // binary number length count
-    int addr = 0;        // score table address
-    int maxValue = 0;    // current max value
-    int maxType = NONE;  // current max type
-    // find starting x and y coordinate of current diagonal
-    int start_x = 0, start_y = 0;
-    if (x < y)
-      start_y = y - x;
-    else
-      start_x = x - y;
-    // find index of the diagonal in score table
-    int index = (start_y == 0) ? start_x : Game::BOARD_SIZE + start_y - 1;
-    // iterate through each grid at current diagonal
-    for (int j = 0; j < Game::BOARD_SIZE; j++) {
-      // if x or y exceed valid range then break
-      if (start_x >= Game::BOARD_SIZE || start_y >= Game::BOARD_SIZE) break;
-      addr <<= 2;  // NOLINT
-      k += 2;
-      if (chess[start_x][start_y] == me) addr |= 1;        // NOLINT
-      if (chess[start_x][start_y] == opponent) addr |= 2;  // NOLINT
-      // if binary number length reach bit data length threshold
-      // retrieve corresponding score from table
-      if (k >= BIT_DATA_LENGTH) {
-        int value = score_table[addr & BIT_DATA_SIZE];  // NOLINT
-        if (value > maxValue) {
-          // update max score
-          maxValue = value;
-          maxType = score_type_table[addr & BIT_DATA_SIZE];  // NOLINT
-        }
-      }
-      start_x++;
-      start_y++;
+  Stone ponder_board[N][N];
+  memcpy(ponder_board, board, sizeof(ponder_board));
+  ponder_board[x][y] = opponent;
+  BeginSearch();
+  // the time limit only starts once the reply is played
+  SetSearchDeadline(0);
+  pondering = true;
+  ponder_x = x;
+  ponder_y = y;
+  LaunchSearch(ponder_board,
+               (opponent == Stone::BLACK) ? Stone::WHITE : Stone::BLACK,
+               multi_thread);
+  search.id = background_id;
+  return search;
+}
+
+template <int N, int K>
+bool BasicAlphaBetaAlgorithm<N, K>::GetPonderMove(int& x, int& y) const {
+  if (!pondering) return false;
+  x = ponder_x;
+  y = ponder_y;
+  return true;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::BeginSearch() {
+  stop_search.store(false);
+  SetSearchDeadline(limits.time_limit_ms);
+  progress_depth.store(0);
+  progress_value.store(0);
+  progress_move.store(-1);
+  ponder_hit = false;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::LaunchSearch(Stone board[N][N],
+                                                 Stone player,
+                                                 bool multi_thread) {
+  background_id = ++search_count;
+  memcpy(background_board, board, sizeof(background_board));
+  background_player = player;
+  background_search = std::async(std::launch::async, [this, multi_thread]() {
+    return Search(background_board, background_player, background_x,
+                  background_y, multi_thread);
+  });
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::StopSearch() {
+  if (!background_search.valid()) return;
+  stop_search.store(true);
+  background_search.get();
+  pondering = false;
+}
+
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::TakeBackgroundResult(int& x, int& y) {
+  if (!background_search.valid()) return 0;
+  int result = background_search.get();
+  pondering = false;
+  x = background_x;
+  y = background_y;
+  return result;
+}
+
+template <int N, int K>
+bool BasicAlphaBetaAlgorithm<N, K>::ContinuePondering(Stone board[N][N],
+                                                      Stone player) {
+  if (!background_search.valid()) return false;
+  if (pondering && player == background_player &&
+      memcmp(board, background_board, sizeof(background_board)) == 0) {
+    // ponder hit, the search so far is for free and the budget starts now
+    pondering = false;
+    ponder_hit = true;
+    SetSearchDeadline(limits.time_limit_ms);
+    return true;
+  }
+  // ponder miss, the tables it filled are still useful
+  StopSearch();
+  return false;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::ReportProgress(int depth, int value, int x,
+                                                   int y) {
+  progress_depth.store(depth);
+  progress_value.store(value);
+  progress_move.store(x * N + y);
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SearchRootSplit(
+    const SearchPosition& position, Stone player, std::vector<RootMove>& moves,
+    int& x, int& y) {
+  // initialize thread parameter, pass game info into each root move task
+  ThreadPool& pool = GetThreadPool();
+  std::vector<MinMaxThreadParam> threadParam(moves.size());
+  for (auto& i : threadParam) {
+    i.position = position;
+    i.pAlgorithm = this;
+    i.maxPlayer = player;
+    i.player = (player == Stone::BLACK) ? Stone::WHITE : Stone::BLACK;
+  }
+  // iterative deepening, each iteration searches one level deeper and
+  // starts from the best move of previous iteration
+  for (int depth = 1; depth <= limits.max_depth; depth++) {
+    TaskGroup group;
+    // queue every root move, idle workers steal from busy ones
+    for (size_t m = 0; m < moves.size(); m++) {
+      MinMaxThreadParam* program = &threadParam[m];
+      program->x = moves[m].row_index;
+      program->y = moves[m].column_index;
+      program->index = static_cast<int>(m);
+      program->depth = depth;
+      pool.Submit(group, [program] { MinMaxThread(program); });
     }
-    // record score for current diagonal
-    pCache->diagonal_score[index] = maxValue;
-    pCache->diagonal_type[index] = maxType;
+    // retrieve result from all tasks
+    pool.Wait(group);
+    for (auto& program : threadParam)
+      moves[program.index].value = program.bestValue;
+    // unfinished iteration is discarded, keep result of previous one
+    if (stop_search.load()) break;
+    best_value = FinishIteration(moves, x, y);
+    completed_depth = depth;
+    ReportProgress(depth, best_value, x, y);
   }
-  // check anti-diagonal
-  if (true) {
-    int k = 0;           // binary number length count
-    int addr = 0;        // score table address
-    int maxValue = 0;    // current max value
-    int maxType = NONE;  // current max type
-    // find starting x and y coordinate of current diagonal
-    int current_x = Game::BOARD_SIZE - 1, current_y = 0;
-    if ((Game::BOARD_SIZE - 1 - x) < y)
-      current_y = y - (Game::BOARD_SIZE - 1 - x);
-    else
-      current_x = x + y;
-    // find index of the diagonal in score tablef
-    int index =
-        (current_y == 0) ? 18 - current_x : current_y + Game::BOARD_SIZE - 1;
-    // iterate through each grid at current diagonal
-    for (int j = 0; j < Game::BOARD_SIZE; j++) {
-      if (current_x < 0 || current_y >= Game::BOARD_SIZE) break;
-      addr <<= 2;  // NOLINT
-      k += 2;
-      if (chess[current_x][current_y] == me) addr |= 1;        // NOLINT
-      if (chess[current_x][current_y] == opponent) addr |= 2;  // NOLINT
-      // if binary number length reach bit data length threshold
-      // retrieve corresponding score from table
-      if (k >= BIT_DATA_LENGTH) {
-        int value = score_table[addr & BIT_DATA_SIZE];  // NOLINT
-        if (value > maxValue) {
-          // update max score
-          maxValue = value;
-          maxType = score_type_table[addr & BIT_DATA_SIZE];  // NOLINT
-        }
-      }
-      current_x--;
-      current_y++;
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::SearchLazySMP(
+    SearchPosition& position, Stone player, const std::vector<RootMove>& moves,
+    int& x, int& y) {
+  ThreadPool& pool = GetThreadPool();
+  // calling thread is the main searcher, workers are helpers
+  int helper_num = pool.GetThreadNum() - 1;
+  std::vector<MinMaxThreadParam> helpers(max(helper_num, 0));
+  // every helper shuffles equal root moves with its own generator
+  unsigned seed = static_cast<unsigned>(root_random());
+  TaskGroup group;
+  for (size_t k = 0; k < helpers.size(); k++) {
+    MinMaxThreadParam* program = &helpers[k];
+    program->position = position;
+    program->pAlgorithm = this;
+    program->maxPlayer = player;
+    // half of the helpers run one level ahead of the main searcher
+    program->depth = 1 + static_cast<int>((k + 1) % 2);
+    // every helper starts from a different root move
+    program->index = static_cast<int>(k + 1);
+    unsigned helper_seed = seed + static_cast<unsigned>(k + 1);
+    pool.Submit(group, [program, helper_seed] {
+      std::mt19937 random(helper_seed);
+      std::vector<RootMove> helper_moves =
+          program->pAlgorithm->GenerateRootMoves(program->position,
+                                                 program->maxPlayer, random);
+      program->pAlgorithm->SearchIterative(
+          program->position, program->maxPlayer, helper_moves, program->depth,
+          static_cast<size_t>(program->index), program->x, program->y,
+          program->bestValue, false);
+    });
+  }
+  // helpers only fill the shared transposition table,
+  // the move returned is the one found by main searcher
+  std::vector<RootMove> main_moves = moves;
+  completed_depth = SearchIterative(position, player, main_moves, 1, 0, x, y,
+                                    best_value, true);
+  // stop helpers once main searcher finishes
+  stop_search.store(true);
+  pool.Wait(group);
+}
+
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::ScoreChessPointToCache(
+    Stone chess[N][N], int x, int y, ScoreCache* pBlackCache,
+    ScoreCache* pWhiteCache) {
+  // rescan row, column, diagonal and anti-diagonal through the point
+  int index[4];
+  GetLineIndex(x, y, index);
+  int lines[4];
+  for (int dir = 0; dir < 4; dir++)
+    lines[dir] = LineScorer::LINE_OFFSET[dir] + index[dir];
+  typename LineScorer::Scores line_scores;
+  LineScorer::ScoreLines(chess, lines, 4, &line_scores);
+  ScoreCache* caches[2] = {pBlackCache, pWhiteCache};
+  for (int c = 0; c < 2; c++) {
+    int* scores[4] = {caches[c]->horizontal_score, caches[c]->vertical_score,
+                      caches[c]->diagonal_score, caches[c]->antiDiagonal_score};
+    int* types[4] = {caches[c]->horizontal_type, caches[c]->vertical_type,
+                     caches[c]->diagonal_type, caches[c]->antiDiagonal_type};
+    for (int dir = 0; dir < 4; dir++) {
+      int type = line_scores.type[c][lines[dir]];
+      caches[c]->type_count[dir][types[dir][index[dir]]]--;
+      scores[dir][index[dir]] = line_scores.score[c][lines[dir]];
+      types[dir][index[dir]] = type;
+      caches[c]->type_count[dir][type]++;
     }
-    // record score for current anti-diagonal
-    pCache->antiDiagonal_score[index] = maxValue;
-    pCache->antiDiagonal_type[index] = maxType;
   }
 }
 
-int AlphaBetaAlgorithm::EvaluateMinMax(
-    Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE], Stone maxPlayer) {
-  // create two ScoreCache for black and white stone
-  ScoreCache tmpBlackScoreCache{};
-  ScoreCache tmpWhiteScoreCache{};
-  // make copy of global ScoreCache to temp ScoreCache
-  memcpy(&tmpBlackScoreCache, &black_score_cache, sizeof(ScoreCache));
-  memcpy(&tmpWhiteScoreCache, &white_score_cache, sizeof(ScoreCache));
-  // for every temporary move
-  for (int i = 0; i < Game::BOARD_SIZE; i++)
-    for (int j = 0; j < Game::BOARD_SIZE; j++)
-      if (board[i][j] != board_backup[i][j]) {
-        ScoreChessPointToCache(board, Stone::BLACK, i, j, &tmpBlackScoreCache);
-        ScoreChessPointToCache(board, Stone::WHITE, i, j, &tmpWhiteScoreCache);
-      }
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::ProbeLeafThreats(SearchPosition& position,
+                                                    Stone player) {
+  const ScoreCache* own = &position.black_score_cache;
+  const ScoreCache* opponent = &position.white_score_cache;
+  if (player == Stone::WHITE) std::swap(own, opponent);
+  int own_four = 0, own_three = 0, opponent_four = 0;
+  for (int dir = 0; dir < 4; dir++) {
+    own_four += own->type_count[dir][OPEN_FOUR] +
+                own->type_count[dir][MAKE_CONSECUTIVE_FOUR];
+    own_three += own->type_count[dir][OPEN_THREE];
+    opponent_four += opponent->type_count[dir][OPEN_FOUR] +
+                     opponent->type_count[dir][MAKE_CONSECUTIVE_FOUR];
+  }
+  // player to move completes a four first
+  if (own_four > 0) return THREAT_WIN_SCORE;
+  // without a three or a four the player has no threat to start with
+  if (own_three == 0) return 0;
+  // the opponent may still answer the three with a four made from a
+  // half-open or split three, or block it on a grid making a four. Only a
+  // sequence read out by the solver is a win. The solver keeps its own
+  // board, every search thread needs one
+  static thread_local ThreatSolver solver;
+  ThreatLimits leaf_limits;
+  leaf_limits.max_depth = LEAF_VCT_DEPTH;
+  leaf_limits.node_limit = LEAF_VCT_NODE_LIMIT;
+  leaf_limits.time_limit_ms = 0;
+  int x, y;
+  if (solver.SolveVct(position.board, player, leaf_limits, x, y))
+    return THREAT_WIN_SCORE;
+  // the three is likely to become an open four, but that is not proven
+  return opponent_four == 0 ? LEAF_THREE_BONUS : 0;
+}
+
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::EvaluateMinMax(SearchPosition& position,
+                                                  Stone player) {
+#if CHECK_INCREMENTAL_EVALUATION
+  // score every line again and compare with the incremental caches
+  ScoreCache fullBlackScoreCache{};
+  ScoreCache fullWhiteScoreCache{};
+  ScoreChessToCache(position.board, &fullBlackScoreCache,
+                    &fullWhiteScoreCache);
+  assert(memcmp(&fullBlackScoreCache, &position.black_score_cache,
+                sizeof(ScoreCache)) == 0);
+  assert(memcmp(&fullWhiteScoreCache, &position.white_score_cache,
+                sizeof(ScoreCache)) == 0);
+  // and the candidate moves with a dilation of the bitboard
+  uint32_t neighbors[N];
+  position.bitboard.GetNeighbors(SEARCH_RANGE, neighbors);
+  for (int i = 0; i < N; i++)
+    assert(neighbors[i] == position.candidates.GetRow(i));
+#endif
   // retrieve final score for black and white
-  int black_max = ScoreChess(&tmpBlackScoreCache);
-  int white_max = ScoreChess(&tmpWhiteScoreCache);
+  int black_max = ScoreChess(&position.black_score_cache);
+  int white_max = ScoreChess(&position.white_score_cache);
   // best score for current player equals my score minus opponent score
-  if (maxPlayer == Stone::BLACK)
+  if (player == Stone::BLACK)
     return black_max - white_max;
   else
     return white_max - black_max;
 }
 
-int AlphaBetaAlgorithm::ScoreChess(ScoreCache* pCache) {
-  int best_row_score = 0, best_row_type = 0;
-  int best_column_score = 0, best_column_type = 0;
-  int best_diagonal_score = 0, best_diagonal_type = 0;
-  int best_antiDiagonal_score = 0, best_antiDiagonal_type = 0;
-  // iterate through each row and column
-  for (int i = 0; i < Game::BOARD_SIZE; i++) {
-    // find best row type based on row score
-    if (pCache->horizontal_score[i] > best_row_score) {
-      best_row_score = pCache->horizontal_score[i];
-      best_row_type = pCache->horizontal_type[i];
-    }
-    // find best column type based on column score
-    if (pCache->vertical_score[i] > best_column_score) {
-      best_column_score = pCache->vertical_score[i];
-      best_column_type = pCache->vertical_type[i];
-    }
-  }
-  // iterate through each diagonal and anti-diagonal
-  for (int i = 0; i < 2 * Game::BOARD_SIZE - 1; i++) {
-    // find best diagonal type based on diagonal score
-    if (pCache->diagonal_score[i] > best_diagonal_score) {
-      best_diagonal_score = pCache->diagonal_score[i];
-      best_diagonal_type = pCache->diagonal_type[i];
-    }
-    // find best anti-diagonal type based on anti-diagonal score
-    if (pCache->antiDiagonal_score[i] > best_antiDiagonal_score) {
-      best_antiDiagonal_score = pCache->antiDiagonal_score[i];
-      best_antiDiagonal_type = pCache->antiDiagonal_type[i];
-    }
-  }
-  // find max value among row, column, diagonal, and anti-diagonal
-  int value = max(best_row_score,
-                  max(best_column_score,
-                      max(best_diagonal_score, best_antiDiagonal_score)));
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::ScoreChess(const ScoreCache* pCache) const {
+  int value = 0;
   // count number of occurrence of each type
   int consecutive_four = 0, open_three = 0, half_open_three = 0, open_two = 0,
       half_open_two = 0;
-  switch (best_row_type) {
-    case OPEN_FOUR:
-      consecutive_four++;
-      break;
-    case OPEN_THREE:
-      open_three++;
-      break;
-    case HALF_OPEN_THREE:
-      half_open_three++;
-      break;
-    case HALF_OPEN_TWO:
-      half_open_two++;
-      break;
-    case OPEN_TWO:
-      open_two++;
-      break;
-    default:
-      break;
-  }
-  switch (best_column_type) {
-    case OPEN_FOUR:
-      consecutive_four++;
-      break;
-    case OPEN_THREE:
-      open_three++;
-      break;
-    case HALF_OPEN_THREE:
-      half_open_three++;
-      break;
-    case HALF_OPEN_TWO:
-      half_open_two++;
-      break;
-    case OPEN_TWO:
-      open_two++;
-      break;
-    default:
-      break;
-  }
-  switch (best_diagonal_type) {
-    case OPEN_FOUR:
-      consecutive_four++;
-      break;
-    case OPEN_THREE:
-      open_three++;
-      break;
-    case HALF_OPEN_THREE:
-      half_open_three++;
-      break;
-    case HALF_OPEN_TWO:
-      half_open_two++;
-      break;
-    case OPEN_TWO:
-      open_two++;
-      break;
-    default:
-      break;
-  }
-  switch (best_antiDiagonal_type) {
-    case OPEN_FOUR:
-      consecutive_four++;
-      break;
-    case OPEN_THREE:
-      open_three++;
-      break;
-    case HALF_OPEN_THREE:
-      half_open_three++;
-      break;
-    case HALF_OPEN_TWO:
-      half_open_two++;
-      break;
-    case OPEN_TWO:
-      open_two++;
-      break;
-    default:
-      break;
+  // row, column, diagonal, and anti-diagonal
+  for (int dir = 0; dir < 4; dir++) {
+    // pattern types are ordered from highest to lowest score,
+    // the first type found is the best line of this direction
+    int best_type = NONE;
+    for (int type = CONSECUTIVE_FIVE; type <= HALF_OPEN_TWO; type++) {
+      if (pCache->type_count[dir][type] > 0) {
+        best_type = type;
+        break;
+      }
+    }
+    // find max value among row, column, diagonal, and anti-diagonal
+    value = max(value, type_score[best_type]);
+    switch (best_type) {
+      case OPEN_FOUR:
+        consecutive_four++;
+        break;
+      case OPEN_THREE:
+        open_three++;
+        break;
+      case HALF_OPEN_THREE:
+        half_open_three++;
+        break;
+      case HALF_OPEN_TWO:
+        half_open_two++;
+        break;
+      case OPEN_TWO:
+        open_two++;
+        break;
+      default:
+        break;
+    }
   }
   // score of combination of each type is retrieved from internet
   // not the best probably but works fine
-  if (consecutive_four >= 2) return max(value, 10000);
-  if (consecutive_four >= 1 && open_three >= 1) return max(value, 10000);
-  if (open_three >= 2) return max(value, 5000);
-  if (open_three >= 1 && half_open_three >= 1) return max(value, 1000);
-  if (open_two >= 2) return max(value, 100);
-  if (open_two >= 1 && half_open_two >= 1) return max(value, 10);
+  if (consecutive_four >= 2) return max(value, DOUBLE_FOUR_SCORE);
+  if (consecutive_four >= 1 && open_three >= 1)
+    return max(value, DOUBLE_FOUR_SCORE);
+  if (open_three >= 2) return max(value, DOUBLE_THREE_SCORE);
+  if (open_three >= 1 && half_open_three >= 1)
+    return max(value, THREE_HALF_THREE_SCORE);
+  if (open_two >= 2) return max(value, DOUBLE_TWO_SCORE);
+  if (open_two >= 1 && half_open_two >= 1)
+    return max(value, TWO_HALF_TWO_SCORE);
   // return final score
   return value;
 }
 
-int AlphaBetaAlgorithm::ScorePoint(
-    Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE], Stone player, int x,
-    int y) {
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::ScorePoint(Stone board[N][N], Stone player,
+                                              int x, int y) {
   // find best row, column, diagonal, anti-diagonal score in each direction
   int best_row_score = 0, best_row_type = 0;
   int best_column_score = 0, best_column_type = 0;
@@ -801,19 +1622,23 @@ int AlphaBetaAlgorithm::ScorePoint(
   }
   // score of combination of each type is retrieved from internet
   // not the best probably but works fine
-  if (consecutive_four >= 2) return max(value, 10000);
-  if (consecutive_four >= 1 && open_three >= 1) return max(value, 10000);
-  if (open_three >= 2) return max(value, 5000);
-  if (open_three >= 1 && half_open_three >= 1) return max(value, 1000);
-  if (open_two >= 2) return max(value, 100);
-  if (open_two >= 1 && half_open_two >= 1) return max(value, 10);
+  if (consecutive_four >= 2) return max(value, DOUBLE_FOUR_SCORE);
+  if (consecutive_four >= 1 && open_three >= 1)
+    return max(value, DOUBLE_FOUR_SCORE);
+  if (open_three >= 2) return max(value, DOUBLE_THREE_SCORE);
+  if (open_three >= 1 && half_open_three >= 1)
+    return max(value, THREE_HALF_THREE_SCORE);
+  if (open_two >= 2) return max(value, DOUBLE_TWO_SCORE);
+  if (open_two >= 1 && half_open_two >= 1)
+    return max(value, TWO_HALF_TWO_SCORE);
   // return final score
   return value;
 }
 
-int AlphaBetaAlgorithm::ScorePointDir(
-    Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE], Stone player, int dir,
-    int x, int y, int& type) {
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::ScorePointDir(Stone board[N][N],
+                                                 Stone player, int dir, int x,
+                                                 int y, int& type) {
   int me = player;
   int opponent = me == Stone::BLACK ? Stone::WHITE : Stone::BLACK;
   int max_value = 0;
@@ -823,7 +1648,7 @@ int AlphaBetaAlgorithm::ScorePointDir(
     int k = 0;     // binary number length count
     int addr = 0;  // score table address
     // go through each grid at current row
-    for (int j = 0; j < Game::BOARD_SIZE; j++) {
+    for (int j = 0; j < N; j++) {
       // if it's the player's stone, attach 01
       // if it's opponent's stone, attach 11
       // otherwise attach 00
@@ -834,11 +1659,12 @@ int AlphaBetaAlgorithm::ScorePointDir(
       // if binary number length reach bit data length threshold
       // retrieve corresponding score from table
       if (k >= BIT_DATA_LENGTH) {
-        int value = score_table[addr & BIT_DATA_SIZE];  // NOLINT
+        uint32_t entry = PATTERN_TABLE.entry[addr & BIT_DATA_SIZE];  // NOLINT
+        int value = GetPatternScore(entry);
         if (value > max_value) {
           // update max score
           max_value = value;
-          max_type = score_type_table[addr & BIT_DATA_SIZE];  // NOLINT
+          max_type = GetPatternType(entry);
         }
       }
     }
@@ -846,7 +1672,7 @@ int AlphaBetaAlgorithm::ScorePointDir(
   } else if (dir == 1) {
     int k = 0;     // binary number length count
     int addr = 0;  // score table address
-    for (int j = 0; j < Game::BOARD_SIZE; j++) {
+    for (int j = 0; j < N; j++) {
       // if it's the player's stone, append 01
       // if it's opponent's stone, append 11
       // otherwise append 00
@@ -857,11 +1683,12 @@ int AlphaBetaAlgorithm::ScorePointDir(
       // if binary number length reach bit data length threshold
       // retrieve corresponding score from table
       if (k >= BIT_DATA_LENGTH) {
-        int value = score_table[addr & BIT_DATA_SIZE];  // NOLINT
+        uint32_t entry = PATTERN_TABLE.entry[addr & BIT_DATA_SIZE];  // NOLINT
+        int value = GetPatternScore(entry);
         if (value > max_value) {
           // update max score
           max_value = value;
-          max_type = score_type_table[addr & BIT_DATA_SIZE];  // NOLINT
+          max_type = GetPatternType(entry);
         }
       }
     }
@@ -876,9 +1703,9 @@ int AlphaBetaAlgorithm::ScorePointDir(
     else
       start_x = x - y;
     // iterate through each grid at current diagonal
-    for (int j = 0; j < Game::BOARD_SIZE; j++) {
+    for (int j = 0; j < N; j++) {
       // if x or y exceed valid range then break
-      if (start_x >= Game::BOARD_SIZE || start_y >= Game::BOARD_SIZE) break;
+      if (start_x >= N || start_y >= N) break;
       addr <<= 2;  // NOLINT
       k += 2;
       if (board[start_x][start_y] == me) addr |= 1;        // NOLINT
@@ -886,11 +1713,12 @@ int AlphaBetaAlgorithm::ScorePointDir(
       // if binary number length reach bit data length threshold
       // retrieve corresponding score from table
       if (k >= BIT_DATA_LENGTH) {
-        int value = score_table[addr & BIT_DATA_SIZE];  // NOLINT
+        uint32_t entry = PATTERN_TABLE.entry[addr & BIT_DATA_SIZE];  // NOLINT
+        int value = GetPatternScore(entry);
         if (value > max_value) {
           // update max score
           max_value = value;
-          max_type = score_type_table[addr & BIT_DATA_SIZE];  // NOLINT
+          max_type = GetPatternType(entry);
         }
       }
       start_x++;
@@ -900,14 +1728,13 @@ int AlphaBetaAlgorithm::ScorePointDir(
     int k = 0;     // binary number length count
     int addr = 0;  // score table address
     // find starting x and y coordinate of current diagonal
-    int current_x = Game::BOARD_SIZE - 1, current_y = 0;
-    if ((Game::BOARD_SIZE - 1 - x) < y)
-      current_y = y - (Game::BOARD_SIZE - 1 - x);
+    int current_x = N - 1, current_y = 0;
+    if ((N - 1 - x) < y) current_y = y - (N - 1 - x);
     else
       current_x = x + y;
     // iterate through each grid at current diagonal
-    for (int j = 0; j < Game::BOARD_SIZE; j++) {
-      if (current_x < 0 || current_y >= Game::BOARD_SIZE) break;
+    for (int j = 0; j < N; j++) {
+      if (current_x < 0 || current_y >= N) break;
       addr <<= 2;  // NOLINT
       k += 2;
       if (board[current_x][current_y] == me) addr |= 1;        // NOLINT
@@ -915,11 +1742,12 @@ int AlphaBetaAlgorithm::ScorePointDir(
       // if binary number length reach bit data length threshold
       // retrieve corresponding score from table
       if (k >= BIT_DATA_LENGTH) {
-        int value = score_table[addr & BIT_DATA_SIZE];  // NOLINT
+        uint32_t entry = PATTERN_TABLE.entry[addr & BIT_DATA_SIZE];  // NOLINT
+        int value = GetPatternScore(entry);
         if (value > max_value) {
           // update max score
           max_value = value;
-          max_type = score_type_table[addr & BIT_DATA_SIZE];  // NOLINT
+          max_type = GetPatternType(entry);
         }
       }
       current_x--;
@@ -932,219 +1760,53 @@ int AlphaBetaAlgorithm::ScorePointDir(
   return max_value;
 }
 
-void AlphaBetaAlgorithm::ScoreChessToCache(
-    Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE], Stone player,
-    ScoreCache* pCache) {
-  int me = player;
-  int opponent = me == Stone::BLACK ? Stone::WHITE : Stone::BLACK;
-  // check horizontal
-  if (true) {
-    for (int i = 0; i < Game::BOARD_SIZE; i++) {
-      int k = 0;           // binary number length count
-      int addr = 0;        // score table address
-      int maxValue = 0;    // current max value
-      int maxType = NONE;  // current max type
-      // go through each grid at current row
-      for (int j = 0; j < Game::BOARD_SIZE; j++) {
-        // if it's the player's stone, attach 01
-        // if it's opponent's stone, attach 11
-        // otherwise attach 00
-        addr <<= 2;  // NOLINT
-        k += 2;
-        if (board[j][i] == me) addr |= 1;        // NOLINT
-        if (board[j][i] == opponent) addr |= 2;  // NOLINT
-        // if binary number length reach bit data length threshold
-        // retrieve corresponding score from table
-        if (k >= BIT_DATA_LENGTH) {
-          int value = score_table[addr & BIT_DATA_SIZE];  // NOLINT
-          if (value > maxValue) {
-            // update max score
-            maxValue = value;
-            maxType = score_type_table[addr & BIT_DATA_SIZE];  // NOLINT
-          }
-        }
-      }
-      // record score for current row
-      pCache->horizontal_score[i] = maxValue;
-      pCache->horizontal_type[i] = maxType;
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::ScoreChessToCache(Stone board[N][N],
+                                                      ScoreCache* pBlackCache,
+                                                      ScoreCache* pWhiteCache) {
+  // score every line for both players at once
+  typename LineScorer::Scores line_scores;
+  LineScorer::ScoreBoard(board, &line_scores);
+  ScoreCache* caches[2] = {pBlackCache, pWhiteCache};
+  for (int c = 0; c < 2; c++) {
+    ScoreCache* pCache = caches[c];
+    const int* scores = line_scores.score[c];
+    const int* types = line_scores.type[c];
+    memcpy(pCache->horizontal_score, scores + LineScorer::LINE_OFFSET[0],
+           sizeof(pCache->horizontal_score));
+    memcpy(pCache->horizontal_type, types + LineScorer::LINE_OFFSET[0],
+           sizeof(pCache->horizontal_type));
+    memcpy(pCache->vertical_score, scores + LineScorer::LINE_OFFSET[1],
+           sizeof(pCache->vertical_score));
+    memcpy(pCache->vertical_type, types + LineScorer::LINE_OFFSET[1],
+           sizeof(pCache->vertical_type));
+    memcpy(pCache->diagonal_score, scores + LineScorer::LINE_OFFSET[2],
+           sizeof(pCache->diagonal_score));
+    memcpy(pCache->diagonal_type, types + LineScorer::LINE_OFFSET[2],
+           sizeof(pCache->diagonal_type));
+    memcpy(pCache->antiDiagonal_score, scores + LineScorer::LINE_OFFSET[3],
+           sizeof(pCache->antiDiagonal_score));
+    memcpy(pCache->antiDiagonal_type, types + LineScorer::LINE_OFFSET[3],
+           sizeof(pCache->antiDiagonal_type));
+    // count lines of each pattern type in every direction
+    memset(pCache->type_count, 0, sizeof(pCache->type_count));
+    for (int i = 0; i < N; i++) {
+      pCache->type_count[0][pCache->horizontal_type[i]]++;
+      pCache->type_count[1][pCache->vertical_type[i]]++;
     }
-  }
-  // check vertial
-  if (true) {
-    for (int i = 0; i < Game::BOARD_SIZE; i++) {
-      int k = 0;           // binary number length count
-      int addr = 0;        // score table address
-      int maxValue = 0;    // current max value
-      int maxType = NONE;  // current max type
-      for (int j = 0; j < Game::BOARD_SIZE; j++) {
-        // if it's the player's stone, append 01
-        // if it's opponent's stone, append 11
-        // otherwise append 00
-        addr <<= 2;  // NOLINT
-        k += 2;
-        if (board[i][j] == me) addr |= 1;        // NOLINT
-        if (board[i][j] == opponent) addr |= 2;  // NOLINT
-        // if binary number length reach bit data length threshold
-        // retrieve corresponding score from table
-        if (k >= BIT_DATA_LENGTH) {
-          int value = score_table[addr & BIT_DATA_SIZE];  // NOLINT
-          if (value > maxValue) {
-            // update max score
-            maxValue = value;
-            maxType = score_type_table[addr & BIT_DATA_SIZE];  // NOLINT
-          }
-        }
-      }
-      // record score for current column
-      pCache->vertical_score[i] = maxValue;
-      pCache->vertical_type[i] = maxType;
-    }
-  }
-  // check diagonal
-  if (true) {
-    // check for lower side of diagonal
-    for (int i = 0; i < Game::BOARD_SIZE; i++) {
-      int k = 0;           // binary number length count
-      int addr = 0;        // score table address
-      int maxValue = 0;    // current max value
-      int maxType = NONE;  // current max type
-      // find starting x and y coordinate of current diagonal
-      int start_x = i, start_y = 0;
-      // iterate through each grid at current diagonal
-      for (int j = 0; j < Game::BOARD_SIZE; j++) {
-        // if x or y exceed valid range then break
-        if (start_x >= Game::BOARD_SIZE || start_y >= Game::BOARD_SIZE) break;
-        addr <<= 2;  // NOLINT
-        k += 2;
-        if (board[start_x][start_y] == me) addr |= 1;        // NOLINT
-        if (board[start_x][start_y] == opponent) addr |= 2;  // NOLINT
-        // if binary number length reach bit data length threshold
-        // retrieve corresponding score from table
-        if (k >= BIT_DATA_LENGTH) {
-          int value = score_table[addr & BIT_DATA_SIZE];  // NOLINT
-          if (value > maxValue) {
-            // update max score
-            maxValue = value;
-            maxType = score_type_table[addr & BIT_DATA_SIZE];  // NOLINT
-          }
-        }
-        start_x++;
-        start_y++;
-      }
-      // record score for current diagonal
-      pCache->diagonal_score[i] = maxValue;
-      pCache->diagonal_type[i] = maxType;
-    }
-    // check for upper side of diagonal
-    for (int i = 1; i < Game::BOARD_SIZE; i++) {
-      int k = 0;           // binary number length count
-      int addr = 0;        // score table address
-      int maxValue = 0;    // current max value
-      int maxType = NONE;  // current max type
-      // find starting x and y coordinate of current diagonal
-      int start_x = 0, start_y = i;
-      // iterate through each grid at current diagonal
-      for (int j = 0; j < Game::BOARD_SIZE; j++) {
-        // if x or y exceed valid range then break
-        if (start_x >= Game::BOARD_SIZE || start_y >= Game::BOARD_SIZE) break;
-        addr <<= 2;  // NOLINT
-        k += 2;
-        if (board[start_x][start_y] == me) addr |= 1;        // NOLINT
-        if (board[start_x][start_y] == opponent) addr |= 2;  // NOLINT
-        // if binary number length reach bit data length threshold
-        // retrieve corresponding score from table
-        if (k >= BIT_DATA_LENGTH) {
-          int value = score_table[addr & BIT_DATA_SIZE];  // NOLINT
-          if (value > maxValue) {
-            // update max score
-            maxValue = value;
-            maxType = score_type_table[addr & BIT_DATA_SIZE];  // NOLINT
-          }
-        }
-        start_x++;
-        start_y++;
-      }
-      // record score for current diagonal
-      pCache->diagonal_score[i + Game::BOARD_SIZE - 1] = maxValue;
-      pCache->diagonal_type[i + Game::BOARD_SIZE - 1] = maxType;
-    }
-  }
-  // check anti-diagonal
-  if (true) {  // HV2
-    // check for lower side of diagonal
-    for (int i = 0; i < Game::BOARD_SIZE; i++) {
-      int k = 0;           // binary number length count
-      int addr = 0;        // score table address
-      int maxValue = 0;    // current max value
-      int maxType = NONE;  // current max type
-      // find starting x and y coordinate of current diagonal
-      int start_x = Game::BOARD_SIZE - 1 - i, start_y = 0;
-      // iterate through each grid at current diagonal
-      for (int j = 0; j < Game::BOARD_SIZE; j++) {
-        // if x or y exceed valid range then break
-        if (start_x < 0 || start_y >= Game::BOARD_SIZE) break;
-        addr <<= 2;  // NOLINT
-        k += 2;
-        if (board[start_x][start_y] == me) addr |= 1;        // NOLINT
-        if (board[start_x][start_y] == opponent) addr |= 2;  // NOLINT
-        // if binary number length reach bit data length threshold
-        // retrieve corresponding score from table
-        if (k >= BIT_DATA_LENGTH) {
-          int value = score_table[addr & BIT_DATA_SIZE];  // NOLINT
-          if (value > maxValue) {
-            // update max score
-            maxValue = value;
-            maxType = score_type_table[addr & BIT_DATA_SIZE];  // NOLINT
-          }
-        }
-        start_x--;
-        start_y++;
-      }
-      // record score for current diagonal
-      pCache->diagonal_score[i] = maxValue;
-      pCache->diagonal_type[i] = maxType;
-    }
-    // check for upper side of diagonal
-    for (int i = 1; i < Game::BOARD_SIZE; i++) {
-      int k = 0;           // binary number length count
-      int addr = 0;        // score table address
-      int maxValue = 0;    // current max value
-      int maxType = NONE;  // current max type
-      // find starting x and y coordinate of current diagonal
-      int start_x = Game::BOARD_SIZE - 1, start_y = i;
-      // iterate through each grid at current diagonal
-      for (int j = 0; j < Game::BOARD_SIZE; j++) {
-        // if x or y exceed valid range then break
-        if (start_x >= Game::BOARD_SIZE || start_y >= Game::BOARD_SIZE) break;
-        addr <<= 2;  // NOLINT
-        k += 2;
-        if (board[start_x][start_y] == me) addr |= 1;        // NOLINT
-        if (board[start_x][start_y] == opponent) addr |= 2;  // NOLINT
-        // if binary number length reach bit data length threshold
-        // retrieve corresponding score from table
-        if (k >= BIT_DATA_LENGTH) {
-          int value = score_table[addr & BIT_DATA_SIZE];  // NOLINT
-          if (value > maxValue) {
-            // update max score
-            maxValue = value;
-            maxType = score_type_table[addr & BIT_DATA_SIZE];  // NOLINT
-          }
-        }
-        start_x++;
-        start_y++;
-      }
-      // record score for current diagonal
-      pCache->diagonal_score[i + Game::BOARD_SIZE - 1] = maxValue;
-      pCache->diagonal_type[i + Game::BOARD_SIZE - 1] = maxType;
+    for (int i = 0; i < 2 * N - 1; i++) {
+      pCache->type_count[2][pCache->diagonal_type[i]]++;
+      pCache->type_count[3][pCache->antiDiagonal_type[i]]++;
     }
   }
 }
 
-int AlphaBetaAlgorithm::GetWinner(
-    Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE]) {
-  for (int x = 0; x < Game::BOARD_SIZE; x++) {
-    for (int y = 0; y < Game::BOARD_SIZE; y++) {
-      if (board[x][y] != 0 && Game::IsWin(board, x, y)) {
+template <int N, int K>
+int BasicAlphaBetaAlgorithm<N, K>::GetWinner(Stone board[N][N]) {
+  BitBoard bits(board);
+  for (int x = 0; x < N; x++) {
+    for (int y = 0; y < N; y++) {
+      if (board[x][y] != 0 && bits.IsWin(x, y)) {
         return board[x][y];
       }
     }
@@ -1152,15 +1814,34 @@ int AlphaBetaAlgorithm::GetWinner(
   return Stone::EMPTY;
 }
 
-DWORD WINAPI AlphaBetaAlgorithm::MinMaxThread(void* pParam) {
-  auto* program = (MinMaxThreadParam*)pParam;
+template <int N, int K>
+void BasicAlphaBetaAlgorithm<N, K>::MinMaxThread(MinMaxThreadParam* program) {
+  BasicAlphaBetaAlgorithm* pAlgorithm = program->pAlgorithm;
   // make temporary move
-  program->board[program->x][program->y] = program->maxPlayer;
-  // minimax recursion to find best value
-  program->bestValue = program->pAlgorithm->MinMax(
-      program->board, program->depth, program->maxPlayer, program->player,
-      std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+  MoveUndo undo;
+  pAlgorithm->MakeMove(program->position, program->x, program->y,
+                       program->maxPlayer, undo);
+  // minimax recursion to find best value, negated for the root player
+  program->bestValue =
+      -pAlgorithm->MinMax(program->position, program->depth, program->player,
+                          -SCORE_INFINITY, SCORE_INFINITY, nullptr);
   // reset this grid back to empty
-  program->board[program->x][program->y] = Stone::EMPTY;
-  return 0;
+  UnmakeMove(program->position, program->x, program->y, undo);
+}
+
+template <int N, int K>
+ThreadPool& BasicAlphaBetaAlgorithm<N, K>::GetThreadPool() {
+  if (!thread_pool) {
+    // one worker per hardware thread unless set, fall back to default
+    // thread number
+    int threads = thread_num > 0
+                      ? thread_num
+                      : static_cast<int>(std::thread::hardware_concurrency());
+    thread_pool.reset(new ThreadPool(threads > 0 ? threads : THREAD_NUM));
+  }
+  return *thread_pool;
 }
+
+#define INSTANTIATE_ALPHA_BETA(N, K) \
+  template class BasicAlphaBetaAlgorithm<N, K>;
+FOR_EACH_BOARD_VARIANT(INSTANTIATE_ALPHA_BETA)
@@ -0,0 +1,171 @@
+//
+// Opening book mapped from disk.
+//
+
+#include "mylibrary/OpeningBook.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+OpeningBook::~OpeningBook() { Close(); }
+
+bool OpeningBook::Open(const std::string& path, int board_size,
+                       int win_length) {
+  Close();
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) return false;
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size) ||
+      file_size.QuadPart < static_cast<LONGLONG>(sizeof(BookHeader))) {
+    CloseHandle(file);
+    return false;
+  }
+  HANDLE map = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  void* view = map ? MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (!view) {
+    if (map) CloseHandle(map);
+    CloseHandle(file);
+    return false;
+  }
+  file_handle = file;
+  map_handle = map;
+  mapping = view;
+  mapping_size = static_cast<size_t>(file_size.QuadPart);
+#else
+  int file = open(path.c_str(), O_RDONLY);
+  if (file < 0) return false;
+  struct stat file_status {};
+  if (fstat(file, &file_status) != 0 ||
+      file_status.st_size < static_cast<off_t>(sizeof(BookHeader))) {
+    close(file);
+    return false;
+  }
+  size_t size = static_cast<size_t>(file_status.st_size);
+  void* view = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+  // the mapping stays valid after the descriptor is closed
+  close(file);
+  if (view == MAP_FAILED) return false;
+  mapping = view;
+  mapping_size = size;
+#endif
+  // reject files of another format or board, or cut short
+  const BookHeader* header = static_cast<const BookHeader*>(mapping);
+  size_t capacity = (mapping_size - sizeof(BookHeader)) / sizeof(BookEntry);
+  if (memcmp(header->magic, BOOK_MAGIC, sizeof(BOOK_MAGIC)) != 0 ||
+      header->version != BOOK_VERSION || header->entry_num > capacity ||
+      header->board_size != static_cast<uint32_t>(board_size) ||
+      header->win_length != static_cast<uint32_t>(win_length)) {
+    Close();
+    return false;
+  }
+  entries = reinterpret_cast<const BookEntry*>(header + 1);
+  entry_num = header->entry_num;
+  this->board_size = board_size;
+  return true;
+}
+
+void OpeningBook::Close() {
+  if (mapping) {
+#ifdef _WIN32
+    UnmapViewOfFile(mapping);
+    CloseHandle(map_handle);
+    CloseHandle(file_handle);
+    map_handle = nullptr;
+    file_handle = nullptr;
+#else
+    munmap(mapping, mapping_size);
+#endif
+  }
+  mapping = nullptr;
+  mapping_size = 0;
+  entries = nullptr;
+  entry_num = 0;
+  board_size = 0;
+}
+
+template <int N>
+bool OpeningBook::Probe(Stone board[N][N], Stone player, int& x,
+                        int& y) const {
+  if (entry_num == 0) return false;
+  BasicSymmetricHash<N> hash;
+  hash.Init(board);
+  return Probe(hash, board, player, x, y);
+}
+
+template <int N>
+bool OpeningBook::Probe(const BasicSymmetricHash<N>& hash, Stone board[N][N],
+                        Stone player, int& x, int& y) const {
+  if (entry_num == 0 || board_size != N) return false;
+  int symmetry;
+  uint64_t key = hash.Canonical(symmetry) ^ BasicZobrist<N>::TurnKey(player);
+  const BookEntry* last = entries + entry_num;
+  const BookEntry* entry = std::lower_bound(
+      entries, last, key,
+      [](const BookEntry& a, uint64_t b) { return a.key < b; });
+  if (entry == last || entry->key != key) return false;
+  // the move is stored for the canonical board, map it back
+  int move_x, move_y;
+  BasicZobrist<N>::InverseTransform(symmetry, entry->row_index,
+                                    entry->column_index, move_x, move_y);
+  // a colliding key may point at an occupied grid
+  if (move_x < 0 || move_x >= N || move_y < 0 || move_y >= N ||
+      board[move_x][move_y] != Stone::EMPTY)
+    return false;
+  x = move_x;
+  y = move_y;
+  return true;
+}
+
+template <int N>
+uint64_t OpeningBook::GetKey(Stone board[N][N], Stone player, int& symmetry) {
+  return BasicZobrist<N>::CanonicalHash(board, symmetry) ^
+         BasicZobrist<N>::TurnKey(player);
+}
+
+bool OpeningBook::Write(const std::string& path,
+                        std::vector<BookEntry> book_entries, int board_size,
+                        int win_length) {
+  std::sort(
+      book_entries.begin(), book_entries.end(),
+      [](const BookEntry& a, const BookEntry& b) { return a.key < b.key; });
+  BookHeader header{};
+  memcpy(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC));
+  header.version = BOOK_VERSION;
+  header.entry_num = static_cast<uint32_t>(book_entries.size());
+  header.board_size = static_cast<uint32_t>(board_size);
+  header.win_length = static_cast<uint32_t>(win_length);
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) return false;
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(book_entries.data()),
+             static_cast<std::streamsize>(book_entries.size() *
+                                          sizeof(BookEntry)));
+  return static_cast<bool>(file);
+}
+
+#define INSTANTIATE_BOOK_PROBE(N, K)                                         \
+  template bool OpeningBook::Probe<N>(Stone[N][N], Stone, int&, int&) const; \
+  template bool OpeningBook::Probe<N>(const BasicSymmetricHash<N>&,          \
+                                      Stone[N][N], Stone, int&, int&) const; \
+  template uint64_t OpeningBook::GetKey<N>(Stone[N][N], Stone, int&);
+FOR_EACH_BOARD_VARIANT(INSTANTIATE_BOOK_PROBE)
@@ -0,0 +1,19 @@
+//
+// Score and type of every line pattern, generated at compile time.
+//
+
+#include "mylibrary/PatternTable.h"
+
+// every type and score fits its bits of an entry
+static_assert(CLOSE_TWO < 1 << PATTERN_TYPE_BITS,  // NOLINT
+              "pattern type does not fit a table entry");
+static_assert(PATTERNS[0].score < 1 << (32 - PATTERN_TYPE_BITS),  // NOLINT
+              "pattern score does not fit a table entry");
+
+constexpr PatternTable PATTERN_TABLE = MakePatternTable();
+
+// five in a row, and a four blocked by an opponent stone
+static_assert(GetPatternType(PATTERN_TABLE.entry[0x155]) == CONSECUTIVE_FIVE,
+              "pattern table is not generated");
+static_assert(PATTERN_TABLE.entry[0x956] == PackPattern(0, CLOSE_FOUR),
+              "pattern table is not generated");
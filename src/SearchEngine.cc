@@ -0,0 +1,64 @@
+//
+// Search engine of a board size chosen at run time.
+//
+
+#include "mylibrary/SearchEngine.h"
+
+#include <cstring>
+
+namespace {
+/**
+ * search engine wrapping the algorithm of one board variant
+ * @tparam N board size
+ * @tparam K number of stones in a row to win
+ */
+template <int N, int K>
+class VariantEngine : public SearchEngine {
+ public:
+  explicit VariantEngine(size_t table_size) : algorithm(table_size) {}
+  int GetBoardSize() const override { return N; }
+  int GetWinLength() const override { return K; }
+  int AlphaBetaGo(const Stone* board, Stone player, int& x, int& y) override {
+    Stone grids[N][N];
+    memcpy(grids, board, sizeof(grids));
+    return algorithm.AlphaBetaGo(grids, player, x, y);
+  }
+  int AlphaBetaGoMT(const Stone* board, Stone player, int& x, int& y) override {
+    Stone grids[N][N];
+    memcpy(grids, board, sizeof(grids));
+    return algorithm.AlphaBetaGoMT(grids, player, x, y);
+  }
+  void SetSearchLimits(const SearchLimits& search_limits) override {
+    algorithm.SetSearchLimits(search_limits);
+  }
+  SearchLimits GetSearchLimits() const override {
+    return algorithm.GetSearchLimits();
+  }
+  SearchStatistics GetStatistics() const override {
+    return algorithm.GetStatistics();
+  }
+  void SetParallelMode(ParallelMode mode) override {
+    algorithm.SetParallelMode(mode);
+  }
+  void SetTranspositionTableSize(size_t table_size) override {
+    algorithm.SetTranspositionTableSize(table_size);
+  }
+  bool LoadOpeningBook(const std::string& path) override {
+    return algorithm.LoadOpeningBook(path);
+  }
+
+ private:
+  BasicAlphaBetaAlgorithm<N, K> algorithm;
+};
+}  // namespace
+
+std::unique_ptr<SearchEngine> CreateSearchEngine(int board_size,
+                                                 int win_length,
+                                                 size_t table_size) {
+#define CREATE_VARIANT_ENGINE(N, K)           \
+  if (board_size == (N) && win_length == (K)) \
+    return std::unique_ptr<SearchEngine>(new VariantEngine<N, K>(table_size));
+  FOR_EACH_BOARD_VARIANT(CREATE_VARIANT_ENGINE)
+#undef CREATE_VARIANT_ENGINE
+  return nullptr;
+}
@@ -0,0 +1,119 @@
+//
+// Persistent work-stealing thread pool used by parallel search.
+//
+
+#include "mylibrary/ThreadPool.h"
+
+#include <chrono>
+
+namespace {
+// pool and index of the worker running on current thread
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local int current_index = -1;
+}  // namespace
+
+ThreadPool::ThreadPool(int thread_num)
+    : queued(0), next_queue(0), stopping(false) {
+  if (thread_num <= 0)
+    thread_num = static_cast<int>(std::thread::hardware_concurrency());
+  if (thread_num <= 0) thread_num = 1;
+  // create all queues before any worker starts stealing
+  for (int i = 0; i < thread_num; i++)
+    queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+  for (int i = 0; i < thread_num; i++)
+    workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_lock);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (auto& worker : workers) worker.join();
+}
+
+int ThreadPool::CurrentWorker() const {
+  return current_pool == this ? current_index : -1;
+}
+
+void ThreadPool::Submit(TaskGroup& group, std::function<void()> task) {
+  group.pending.fetch_add(1);
+  // workers keep their own tasks, outside tasks are spread over all queues
+  int index = CurrentWorker();
+  size_t queue = index >= 0 ? static_cast<size_t>(index)
+                            : next_queue.fetch_add(1) % queues.size();
+  {
+    std::lock_guard<std::mutex> lock(queues[queue]->lock);
+    queues[queue]->tasks.push_back(Task{std::move(task), &group});
+  }
+  queued.fetch_add(1);
+  // lock so that a worker about to sleep can not miss the notification
+  { std::lock_guard<std::mutex> lock(sleep_lock); }
+  wake.notify_one();
+}
+
+bool ThreadPool::PopTask(size_t queue, bool steal, Task& task) {
+  std::lock_guard<std::mutex> lock(queues[queue]->lock);
+  std::deque<Task>& tasks = queues[queue]->tasks;
+  if (tasks.empty()) return false;
+  if (steal) {
+    task = std::move(tasks.back());
+    tasks.pop_back();
+  } else {
+    task = std::move(tasks.front());
+    tasks.pop_front();
+  }
+  queued.fetch_sub(1);
+  return true;
+}
+
+bool ThreadPool::RunPendingTask(int index) {
+  if (queued.load() == 0) return false;
+  Task task;
+  bool found = index >= 0 && PopTask(static_cast<size_t>(index), false, task);
+  // steal from other queues, starting from the next one. Thread outside
+  // of the pool has no queue, it runs tasks in the order they are queued
+  size_t start = index >= 0 ? static_cast<size_t>(index) + 1 : 0;
+  bool steal = index >= 0;
+  for (size_t i = 0; !found && i < queues.size(); i++) {
+    size_t victim = (start + i) % queues.size();
+    if (static_cast<int>(victim) != index) found = PopTask(victim, steal, task);
+  }
+  if (!found) return false;
+  task.run();
+  // count down under the lock, so that the waiting thread can not destroy
+  // the group before this thread leaves it
+  std::lock_guard<std::mutex> lock(task.group->lock);
+  // the last task of the group wakes up the waiting thread
+  if (task.group->pending.fetch_sub(1) == 1) task.group->done.notify_all();
+  return true;
+}
+
+void ThreadPool::Wait(TaskGroup& group) {
+  int index = CurrentWorker();
+  while (true) {
+    // help running queued tasks instead of blocking
+    if (!group.IsDone() && RunPendingTask(index)) continue;
+    // only return while holding the lock, the last task releases it
+    // after its final access to the group
+    std::unique_lock<std::mutex> lock(group.lock);
+    if (group.IsDone()) return;
+    // tasks of the group are running on other threads. Wake up from time
+    // to time since they may queue new tasks that this thread can help with
+    group.done.wait_for(lock, std::chrono::milliseconds(1));
+    if (group.IsDone()) return;
+  }
+}
+
+void ThreadPool::WorkerLoop(int index) {
+  current_pool = this;
+  current_index = index;
+  while (true) {
+    if (RunPendingTask(index)) continue;
+    std::unique_lock<std::mutex> lock(sleep_lock);
+    // sleep until there is a task to run, finish queued tasks before exit
+    wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+    if (stopping && queued.load() == 0) return;
+  }
+}
@@ -0,0 +1,469 @@
+//
+// Threat space search for forced wins.
+//
+
+#include "mylibrary/ThreatSolver.h"
+
+#include <cstring>
+
+#include "mylibrary/BitBoard.h"
+#include "mylibrary/MiniMax.h"
+#include "mylibrary/PatternTable.h"
+#include "mylibrary/Zobrist.h"
+
+namespace {
+// row, column, diagonal, anti-diagonal
+const int DX[4] = {0, 1, 1, 1};
+const int DY[4] = {1, 0, 1, -1};
+// grids of a line address
+const int LINE_WINDOW = BIT_DATA_LENGTH / 2;
+// farthest grid of an open three from the move making it
+const int THREE_REACH = LINE_WINDOW - 2;
+// marks cache keys of continuous threats search
+const uint64_t VCT_KEY = 0x9e3779b97f4a7c15ULL;
+// check the clock once every this many nodes
+const long long CLOCK_CHECK_INTERVAL = 256;
+
+template <int N>
+bool IsOnBoard(int x, int y) {
+  return x >= 0 && x < N && y >= 0 && y < N;
+}
+
+int CountBits(uint32_t line) {
+  int count = 0;
+  for (; line != 0; line &= line - 1U) count++;
+  return count;
+}
+}  // namespace
+
+template <int N, int K>
+BasicThreatSolver<N, K>::BasicThreatSolver()
+    : hash(0),
+      best_x(-1),
+      best_y(-1),
+      nodes(0),
+      node_limit(0),
+      time_limit_ms(0),
+      stop(nullptr),
+      aborted(false),
+      cache(THREAT_CACHE_SIZE, CacheEntry{0, -1, false}) {
+  memset(board, 0, sizeof(board));
+}
+
+template <int N, int K>
+bool BasicThreatSolver<N, K>::SolveVcf(Stone chess[N][N], Stone attacker,
+                                       int& x, int& y) {
+  memcpy(board, chess, sizeof(board));
+  bits = BitBoard(board);
+  hash = Zobrist::Hash(board);
+  nodes = 0;
+  node_limit = VCF_NODE_LIMIT;
+  time_limit_ms = 0;
+  stop = nullptr;
+  aborted = false;
+  best_x = -1;
+  best_y = -1;
+  if (!SearchVcf(attacker, VCF_MAX_DEPTH, 0)) return false;
+  x = best_x;
+  y = best_y;
+  return true;
+}
+
+template <int N, int K>
+bool BasicThreatSolver<N, K>::SolveVct(Stone chess[N][N], Stone attacker,
+                                       const ThreatLimits& limits, int& x,
+                                       int& y) {
+  memcpy(board, chess, sizeof(board));
+  bits = BitBoard(board);
+  hash = Zobrist::Hash(board);
+  nodes = 0;
+  node_limit = limits.node_limit;
+  time_limit_ms = limits.time_limit_ms;
+  start = std::chrono::steady_clock::now();
+  stop = limits.stop;
+  aborted = false;
+  best_x = -1;
+  best_y = -1;
+  if (!SearchVct(attacker, limits.max_depth, 0)) return false;
+  x = best_x;
+  y = best_y;
+  return true;
+}
+
+template <int N, int K>
+bool BasicThreatSolver<N, K>::FindFiveMove(Stone chess[N][N], Stone player,
+                                           int& x, int& y) {
+  ThreatGrids threats;
+  FindThreats(BitBoard(chess), player, threats);
+  if (threats.five_num == 0) return false;
+  x = threats.fives[0] / N;
+  y = threats.fives[0] % N;
+  return true;
+}
+
+template <int N, int K>
+bool BasicThreatSolver<N, K>::SearchVcf(Stone attacker, int depth, int ply) {
+  if (IsBudgetExceeded()) return false;
+  // solved before, a win is searched again at the root to get the move
+  uint64_t key = hash ^ Zobrist::TurnKey(attacker);
+  bool cached_win;
+  if (LookUp(key, depth, cached_win) && (!cached_win || ply > 0))
+    return cached_win;
+  Stone defender = (attacker == Stone::BLACK) ? Stone::WHITE : Stone::BLACK;
+  ThreatGrids own;
+  FindThreats(bits, attacker, own);
+  // attacker completes five right away
+  if (own.five_num > 0) {
+    if (ply == 0) {
+      best_x = own.fives[0] / N;
+      best_y = own.fives[0] % N;
+    }
+    return true;
+  }
+  // a five threat of the defender must be blocked, two can not be
+  ThreatGrids opponent;
+  FindThreats(bits, defender, opponent);
+  if (opponent.five_num >= 2 || depth == 0) return false;
+  for (int k = 0; k < own.four_num; k++) {
+    int move = own.fours[k];
+    // the only move that does not lose is blocking the defender
+    if (opponent.five_num == 1 && move != opponent.fives[0]) continue;
+    int x = move / N;
+    int y = move % N;
+    Place(x, y, attacker);
+    // every grid completing five goes through the new stone
+    int replies[K * 4];
+    int reply_num = FindFivesThrough(x, y, replies);
+    bool win = reply_num >= 2;
+    if (reply_num == 1) {
+      int reply_x = replies[0] / N;
+      int reply_y = replies[0] % N;
+      Place(reply_x, reply_y, defender);
+      // the forced reply may complete five for the defender
+      if (!bits.IsWin(reply_x, reply_y))
+        win = SearchVcf(attacker, depth - 1, ply + 1);
+      Remove(reply_x, reply_y);
+    }
+    Remove(x, y);
+    if (win) {
+      if (ply == 0) {
+        best_x = x;
+        best_y = y;
+      }
+      Store(key, depth, true);
+      return true;
+    }
+    if (aborted) return false;
+  }
+  Store(key, depth, false);
+  return false;
+}
+
+template <int N, int K>
+bool BasicThreatSolver<N, K>::SearchVct(Stone attacker, int depth, int ply) {
+  if (IsBudgetExceeded()) return false;
+  uint64_t key = hash ^ Zobrist::TurnKey(attacker) ^ VCT_KEY;
+  bool cached_win;
+  if (LookUp(key, depth, cached_win) && (!cached_win || ply > 0))
+    return cached_win;
+  // continuous fours are the cheapest threats to try
+  if (SearchVcf(attacker, VCF_MAX_DEPTH, ply)) {
+    Store(key, depth, true);
+    return true;
+  }
+  if (aborted || depth == 0) return false;
+  Stone defender = (attacker == Stone::BLACK) ? Stone::WHITE : Stone::BLACK;
+  ThreatGrids own, opponent;
+  FindThreats(bits, attacker, own);
+  FindThreats(bits, defender, opponent);
+  if (opponent.five_num >= 2) return false;
+  // the only move that does not lose is blocking the defender
+  int block = opponent.five_num == 1 ? opponent.fives[0] : -1;
+  bool is_four[N * N] = {};
+  // a four leaves one reply, then open threes continue the attack
+  for (int k = 0; k < own.four_num; k++) {
+    int move = own.fours[k];
+    is_four[move] = true;
+    if (block >= 0 && move != block) continue;
+    int x = move / N;
+    int y = move % N;
+    Place(x, y, attacker);
+    int replies[K * 4];
+    int reply_num = FindFivesThrough(x, y, replies);
+    bool win = reply_num >= 2 ||
+               (reply_num == 1 &&
+                SearchVctReplies(attacker, replies, 1, depth - 1, ply));
+    Remove(x, y);
+    if (win) {
+      if (ply == 0) {
+        best_x = x;
+        best_y = y;
+      }
+      Store(key, depth, true);
+      return true;
+    }
+    if (aborted) return false;
+  }
+  for (int k = 0; k < own.three_num; k++) {
+    int move = own.threes[k];
+    if (is_four[move] || (block >= 0 && move != block)) continue;
+    int x = move / N;
+    int y = move % N;
+    int before[4];
+    for (int dir = 0; dir < 4; dir++)
+      before[dir] = GetLineType(x, y, attacker, dir);
+    Place(x, y, attacker);
+    // grids near every new open three on its line
+    bool is_reply[N * N] = {};
+    int replies[N * N];
+    int reply_num = 0;
+    for (int dir = 0; dir < 4; dir++) {
+      int after = GetLineType(x, y, attacker, dir);
+      if (after != OPEN_THREE || (before[dir] != NONE && before[dir] <= after))
+        continue;
+      for (int d = -THREE_REACH; d <= THREE_REACH; d++) {
+        int new_x = x + d * DX[dir];
+        int new_y = y + d * DY[dir];
+        if (!IsOnBoard<N>(new_x, new_y) || board[new_x][new_y] != Stone::EMPTY)
+          continue;
+        int reply = new_x * N + new_y;
+        if (is_reply[reply]) continue;
+        is_reply[reply] = true;
+        replies[reply_num++] = reply;
+      }
+    }
+    bool win = false;
+    if (reply_num > 0) {
+      // the defender may also answer with a four of its own
+      ThreatGrids counter;
+      FindThreats(bits, defender, counter);
+      for (int n = 0; n < counter.four_num; n++) {
+        if (is_reply[counter.fours[n]]) continue;
+        is_reply[counter.fours[n]] = true;
+        replies[reply_num++] = counter.fours[n];
+      }
+      win = SearchVctReplies(attacker, replies, reply_num, depth - 1, ply);
+    }
+    Remove(x, y);
+    if (win) {
+      if (ply == 0) {
+        best_x = x;
+        best_y = y;
+      }
+      Store(key, depth, true);
+      return true;
+    }
+    if (aborted) return false;
+  }
+  Store(key, depth, false);
+  return false;
+}
+
+template <int N, int K>
+bool BasicThreatSolver<N, K>::SearchVctReplies(Stone attacker,
+                                               const int replies[],
+                                               int reply_num, int depth,
+                                               int ply) {
+  Stone defender = (attacker == Stone::BLACK) ? Stone::WHITE : Stone::BLACK;
+  for (int k = 0; k < reply_num; k++) {
+    int x = replies[k] / N;
+    int y = replies[k] % N;
+    Place(x, y, defender);
+    // the reply may complete five for the defender
+    bool win =
+        !bits.IsWin(x, y) && SearchVct(attacker, depth, ply + 1);
+    Remove(x, y);
+    if (!win) return false;
+  }
+  return true;
+}
+
+template <int N, int K>
+void BasicThreatSolver<N, K>::FindThreats(const BitBoard& bits, Stone player,
+                                          ThreatGrids& threats) {
+  Stone opponent = (player == Stone::BLACK) ? Stone::WHITE : Stone::BLACK;
+  bool is_five[N * N] = {};
+  bool is_four[N * N] = {};
+  bool is_three[N * N] = {};
+  threats.five_num = 0;
+  threats.four_num = 0;
+  threats.three_num = 0;
+  const uint32_t window = (1U << K) - 1U;
+  for (int dir = 0; dir < 4; dir++) {
+    for (int index = 0; index < BitBoard::GetLineNum(dir); index++) {
+      uint32_t own = bits.GetLine(player, dir, index);
+      if (own == 0) continue;
+      // the edge blocks like an opponent stone
+      uint32_t blocked = bits.GetLine(opponent, dir, index) |
+                         ~BitBoard::GetLineMask(dir, index);
+      for (int start = 0; start + K <= N; start++) {
+        uint32_t mask = window << static_cast<unsigned>(start);
+        if ((blocked & mask) != 0) continue;
+        int count = CountBits(own & mask);
+        if (count < K - 3) continue;
+        // every empty grid of the window
+        for (int bit = start; bit < start + K; bit++) {
+          if ((own >> static_cast<unsigned>(bit)) & 1U) continue;
+          int x, y;
+          BitBoard::GetLineGrid(dir, index, bit, x, y);
+          int grid = x * N + y;
+          if (count == K - 1 && !is_five[grid]) {
+            is_five[grid] = true;
+            threats.fives[threats.five_num++] = grid;
+          } else if (count == K - 2 && !is_four[grid]) {
+            is_four[grid] = true;
+            threats.fours[threats.four_num++] = grid;
+          } else if (count == K - 3 && !is_three[grid]) {
+            is_three[grid] = true;
+            threats.threes[threats.three_num++] = grid;
+          }
+        }
+      }
+    }
+  }
+}
+
+template <int N, int K>
+int BasicThreatSolver<N, K>::FindThreeBlocks(const BitBoard& bits,
+                                             Stone player, int grids[]) {
+  Stone opponent = (player == Stone::BLACK) ? Stone::WHITE : Stone::BLACK;
+  bool is_block[N * N] = {};
+  int num = 0;
+  const uint32_t window = (1U << (K + 1)) - 1U;
+  const uint32_t ends = 1U | (1U << K);
+  for (int dir = 0; dir < 4; dir++) {
+    for (int index = 0; index < BitBoard::GetLineNum(dir); index++) {
+      uint32_t own = bits.GetLine(player, dir, index);
+      if (own == 0) continue;
+      // the edge blocks like an opponent stone
+      uint32_t blocked = bits.GetLine(opponent, dir, index) |
+                         ~BitBoard::GetLineMask(dir, index);
+      for (int start = 0; start + K + 1 <= N; start++) {
+        uint32_t mask = window << static_cast<unsigned>(start);
+        if ((blocked & mask) != 0 ||
+            (own & (ends << static_cast<unsigned>(start))) != 0 ||
+            CountBits(own & mask) != K - 2)
+          continue;
+        for (int bit = start; bit <= start + K; bit++) {
+          if ((own >> static_cast<unsigned>(bit)) & 1U) continue;
+          int x, y;
+          BitBoard::GetLineGrid(dir, index, bit, x, y);
+          int grid = x * N + y;
+          if (is_block[grid]) continue;
+          is_block[grid] = true;
+          grids[num++] = grid;
+        }
+      }
+    }
+  }
+  return num;
+}
+
+template <int N, int K>
+int BasicThreatSolver<N, K>::FindFivesThrough(int x, int y, int grids[]) const {
+  Stone player = board[x][y];
+  int num = 0;
+  for (int dir = 0; dir < 4; dir++) {
+    // every window containing (x, y)
+    for (int start = -(K - 1); start <= 0; start++) {
+      int start_x = x + start * DX[dir];
+      int start_y = y + start * DY[dir];
+      if (!IsOnBoard<N>(start_x, start_y) ||
+          !IsOnBoard<N>(start_x + (K - 1) * DX[dir],
+                        start_y + (K - 1) * DY[dir]))
+        continue;
+      int own = 0, empty = -1;
+      for (int k = 0; k < K; k++) {
+        Stone stone = board[start_x + k * DX[dir]][start_y + k * DY[dir]];
+        if (stone == player)
+          own++;
+        else if (stone == Stone::EMPTY)
+          empty = (start_x + k * DX[dir]) * N + start_y + k * DY[dir];
+      }
+      if (own != K - 1 || empty < 0) continue;
+      // skip grids already found through another window
+      bool found = false;
+      for (int k = 0; k < num && !found; k++) found = grids[k] == empty;
+      if (!found) grids[num++] = empty;
+    }
+  }
+  return num;
+}
+
+template <int N, int K>
+int BasicThreatSolver<N, K>::GetLineType(int x, int y, Stone player,
+                                         int dir) const {
+  // 2 bits per grid like the score table, the edge blocks like an
+  // opponent stone
+  int codes[2 * LINE_WINDOW - 1];
+  for (int k = 0; k < 2 * LINE_WINDOW - 1; k++) {
+    int new_x = x + (k - LINE_WINDOW + 1) * DX[dir];
+    int new_y = y + (k - LINE_WINDOW + 1) * DY[dir];
+    if (!IsOnBoard<N>(new_x, new_y))
+      codes[k] = 2;
+    else if (board[new_x][new_y] == player)
+      codes[k] = 1;
+    else if (board[new_x][new_y] == Stone::EMPTY)
+      codes[k] = 0;
+    else
+      codes[k] = 2;
+  }
+  // every window covering the grid
+  int best = NONE;
+  for (int start = 0; start < LINE_WINDOW; start++) {
+    int addr = 0;
+    for (int k = 0; k < LINE_WINDOW; k++)
+      addr = (addr << 2) | codes[start + k];  // NOLINT
+    int type = GetPatternType(PATTERN_TABLE.entry[addr]);
+    if (type != NONE && type <= HALF_OPEN_TWO && (best == NONE || type < best))
+      best = type;
+  }
+  return best;
+}
+
+template <int N, int K>
+bool BasicThreatSolver<N, K>::IsBudgetExceeded() {
+  if (aborted) return true;
+  nodes++;
+  if (nodes > node_limit || (stop && stop->load(std::memory_order_relaxed))) {
+    aborted = true;
+  } else if (time_limit_ms > 0 && nodes % CLOCK_CHECK_INTERVAL == 0) {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    aborted = elapsed >= std::chrono::milliseconds(time_limit_ms);
+  }
+  return aborted;
+}
+
+template <int N, int K>
+bool BasicThreatSolver<N, K>::LookUp(uint64_t key, int depth, bool& win) const {
+  const CacheEntry& entry = cache[key & (THREAT_CACHE_SIZE - 1)];
+  if (entry.key != key) return false;
+  // a win holds with more depth, a failure with less
+  if (entry.win ? entry.depth > depth : entry.depth < depth) return false;
+  win = entry.win;
+  return true;
+}
+
+template <int N, int K>
+void BasicThreatSolver<N, K>::Store(uint64_t key, int depth, bool win) {
+  // a search cut by the budget proves nothing
+  if (aborted && !win) return;
+  cache[key & (THREAT_CACHE_SIZE - 1)] = {key, depth, win};
+}
+
+template <int N, int K>
+void BasicThreatSolver<N, K>::Place(int x, int y, Stone stone) {
+  board[x][y] = stone;
+  bits.Place(x, y, stone);
+  hash ^= Zobrist::Key(x, y, stone);
+}
+
+template <int N, int K>
+void BasicThreatSolver<N, K>::Remove(int x, int y) {
+  hash ^= Zobrist::Key(x, y, board[x][y]);
+  bits.Remove(x, y, board[x][y]);
+  board[x][y] = Stone::EMPTY;
+}
+
+#define INSTANTIATE_THREAT_SOLVER(N, K) template class BasicThreatSolver<N, K>;
+FOR_EACH_BOARD_VARIANT(INSTANTIATE_THREAT_SOLVER)
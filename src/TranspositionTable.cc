@@ -0,0 +1,92 @@
+//
+// Transposition table used by alpha-beta search.
+//
+
+#include "mylibrary/TranspositionTable.h"
+
+TranspositionTable::TranspositionTable(size_t size)
+    : mask(0), generation(0), hits(0), misses(0) {
+  Resize(size);
+}
+
+void TranspositionTable::Resize(size_t size) {
+  // round size down to power of two, so that index is a simple mask
+  size_t power = 1;
+  while (power * 2 <= size) power *= 2;
+  slots.reset(new Slot[power]);
+  mask = power - 1;
+  Clear();
+}
+
+void TranspositionTable::Clear() {
+  for (size_t i = 0; i <= mask; i++) {
+    slots[i].check.store(0, std::memory_order_relaxed);
+    slots[i].data.store(0, std::memory_order_relaxed);
+  }
+  generation.store(0);
+  ResetCounters();
+}
+
+void TranspositionTable::NewSearch() { generation.fetch_add(1); }
+
+void TranspositionTable::ResetCounters() {
+  hits.store(0, std::memory_order_relaxed);
+  misses.store(0, std::memory_order_relaxed);
+}
+
+uint64_t TranspositionTable::Pack(int depth, BoundType bound, int score, int x,
+                                  int y, uint8_t generation) {
+  if (depth > 63) depth = 63;
+  uint64_t data = static_cast<uint32_t>(score);
+  data |= static_cast<uint64_t>(depth) << 32U;
+  data |= static_cast<uint64_t>(bound) << 38U;
+  // move is stored plus one, so that -1 (no move) becomes zero
+  data |= static_cast<uint64_t>(x + 1) << 40U;
+  data |= static_cast<uint64_t>(y + 1) << 48U;
+  data |= static_cast<uint64_t>(generation) << 56U;
+  return data;
+}
+
+void TranspositionTable::Unpack(uint64_t data, TranspositionEntry& entry) {
+  entry.score = static_cast<int>(static_cast<uint32_t>(data & 0xffffffffU));
+  entry.depth = static_cast<int8_t>((data >> 32U) & 0x3fU);
+  entry.bound = static_cast<uint8_t>((data >> 38U) & 0x3U);
+  entry.row_index = static_cast<int8_t>(((data >> 40U) & 0xffU) - 1);
+  entry.column_index = static_cast<int8_t>(((data >> 48U) & 0xffU) - 1);
+}
+
+bool TranspositionTable::Probe(uint64_t key, TranspositionEntry& entry) {
+  Slot& slot = slots[key & mask];
+  uint64_t data = slot.data.load(std::memory_order_relaxed);
+  uint64_t check = slot.check.load(std::memory_order_relaxed);
+  // torn or foreign slot does not pass the xor check
+  if ((check ^ data) != key) {
+    misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  entry.key = key;
+  Unpack(data, entry);
+  hits.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void TranspositionTable::Store(uint64_t key, int depth, BoundType bound,
+                               int score, int x, int y) {
+  Slot& slot = slots[key & mask];
+  uint8_t current = generation.load(std::memory_order_relaxed);
+  uint64_t old_data = slot.data.load(std::memory_order_relaxed);
+  uint64_t old_key = slot.check.load(std::memory_order_relaxed) ^ old_data;
+  TranspositionEntry old{};
+  Unpack(old_data, old);
+  bool old_current = static_cast<uint8_t>(old_data >> 56U) == current;
+  // keep deeper result of current search, replace everything else
+  if (old_key != key && old_current && old.depth > depth) return;
+  // keep previous best move if current search does not find one
+  if (old_key == key && x < 0) {
+    x = old.row_index;
+    y = old.column_index;
+  }
+  uint64_t data = Pack(depth, bound, score, x, y, current);
+  slot.data.store(data, std::memory_order_relaxed);
+  slot.check.store(key ^ data, std::memory_order_relaxed);
+}
@@ -0,0 +1,107 @@
+//
+// Zobrist hashing for gomoku board status.
+//
+
+#include "mylibrary/Zobrist.h"
+
+#include <utility>
+
+template <int N>
+uint64_t BasicZobrist<N>::keys[N][N][3];
+template <int N>
+uint64_t BasicZobrist<N>::symmetric_keys[SYMMETRY_NUM][N][N][3];
+template <int N>
+uint64_t BasicZobrist<N>::turn_keys[3];
+template <int N>
+bool BasicZobrist<N>::initialized = BasicZobrist<N>::InitKeys();
+
+namespace {
+// splitmix64 generator, small and good enough for hashing keys
+uint64_t NextRandom(uint64_t& state) {
+  uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27U)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31U);
+}
+}  // namespace
+
+template <int N>
+bool BasicZobrist<N>::InitKeys() {
+  // fixed seed, so that hash value is stable between runs
+  uint64_t state = 0x676f6d6f6b75ULL;
+  for (auto& row : keys) {
+    for (auto& grid : row) {
+      // empty grid does not contribute to hash
+      grid[Stone::EMPTY] = 0;
+      grid[Stone::BLACK] = NextRandom(state);
+      grid[Stone::WHITE] = NextRandom(state);
+    }
+  }
+  for (auto& key : turn_keys) key = NextRandom(state);
+  // a stone of symmetric image uses the key of the grid it is mapped to
+  for (int s = 0; s < SYMMETRY_NUM; s++) {
+    for (int i = 0; i < N; i++) {
+      for (int j = 0; j < N; j++) {
+        int x, y;
+        Transform(s, i, j, x, y);
+        for (int stone = 0; stone < 3; stone++)
+          symmetric_keys[s][i][j][stone] = keys[x][y][stone];
+      }
+    }
+  }
+  return true;
+}
+
+template <int N>
+uint64_t BasicZobrist<N>::Hash(Stone board[N][N]) {
+  uint64_t hash = 0;
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++) hash ^= keys[i][j][board[i][j]];
+  return hash;
+}
+
+template <int N>
+uint64_t BasicZobrist<N>::CanonicalHash(Stone board[N][N], int& symmetry) {
+  BasicSymmetricHash<N> hash;
+  hash.Init(board);
+  return hash.Canonical(symmetry);
+}
+
+template <int N>
+void BasicZobrist<N>::Transform(int symmetry, int x, int y, int& new_x,
+                                int& new_y) {
+  new_x = (symmetry & 1) ? N - 1 - x : x;     // NOLINT
+  new_y = (symmetry & 2) ? N - 1 - y : y;     // NOLINT
+  if (symmetry & 4) std::swap(new_x, new_y);  // NOLINT
+}
+
+template <int N>
+void BasicZobrist<N>::InverseTransform(int symmetry, int x, int y, int& new_x,
+                                       int& new_y) {
+  // mirrors are their own inverse, undo the swap first
+  if (symmetry & 4) std::swap(x, y);       // NOLINT
+  new_x = (symmetry & 1) ? N - 1 - x : x;  // NOLINT
+  new_y = (symmetry & 2) ? N - 1 - y : y;  // NOLINT
+}
+
+template <int N>
+void BasicSymmetricHash<N>::Init(Stone board[N][N]) {
+  for (uint64_t& hash : hashes) hash = 0;
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++)
+      if (board[i][j] != Stone::EMPTY) Toggle(i, j, board[i][j]);
+}
+
+template <int N>
+uint64_t BasicSymmetricHash<N>::Canonical(int& symmetry) const {
+  // the first of equal hashes, symmetric boards have several
+  symmetry = 0;
+  for (int s = 1; s < SYMMETRY_NUM; s++)
+    if (hashes[s] < hashes[symmetry]) symmetry = s;
+  return hashes[symmetry];
+}
+
+#define INSTANTIATE_ZOBRIST(N, K) \
+  template class BasicZobrist<N>;  \
+  template struct BasicSymmetricHash<N>;
+FOR_EACH_BOARD_VARIANT(INSTANTIATE_ZOBRIST)
@@ -0,0 +1,284 @@
+//
+// Tests of background searches: AlphaBetaGoAsync and pondering.
+//
+
+#include <mylibrary/MiniMax.h>
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <thread>
+
+namespace {
+using Engine = BasicAlphaBetaAlgorithm<15, 5>;
+
+/**
+ * 15x15 board of a short opening, white to move
+ */
+struct Opening {
+  Stone board[15][15] = {};
+  Opening() {
+    board[7][7] = Stone::BLACK;
+    board[7][8] = Stone::WHITE;
+    board[8][8] = Stone::BLACK;
+  }
+};
+
+/**
+ * wait until a background search returns
+ * @param engine engine running the search
+ * @param search search handle
+ * @return whether it returned within ten seconds
+ */
+bool WaitForSearch(const Engine& engine, const SearchHandle& search) {
+  for (int k = 0; k < 1000; k++) {
+    if (engine.IsSearchReady(search)) return true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+}  // namespace
+
+TEST_CASE("Pondering is stopped through its handle", "[search][ponder]") {
+  Opening opening;
+  Engine engine;
+  // deep enough to still run when it is cancelled
+  SearchLimits limits;
+  limits.max_depth = 12;
+  engine.SetSearchLimits(limits);
+  SearchHandle ponder =
+      engine.StartPondering(opening.board, Stone::WHITE, false);
+  REQUIRE(ponder.IsValid());
+  CHECK(engine.GetSearchProgress(ponder).pondering);
+  engine.CancelSearch(ponder);
+  CHECK_FALSE(engine.GetSearchProgress(ponder).pondering);
+  REQUIRE(WaitForSearch(engine, ponder));
+}
+
+TEST_CASE("Pondering does not start once the game is over",
+          "[search][ponder]") {
+  Opening opening;
+  for (int y = 0; y < 5; y++) opening.board[0][y] = Stone::BLACK;
+  Engine engine;
+  CHECK_FALSE(
+      engine.StartPondering(opening.board, Stone::WHITE, false).IsValid());
+}
+
+TEST_CASE("A ponder hit keeps the pondering search", "[search][ponder]") {
+  Opening opening;
+  SearchLimits limits;
+  limits.max_depth = 3;
+  Engine engine;
+  engine.SetSearchLimits(limits);
+  engine.SetRandomSeed(1);
+  SearchHandle ponder =
+      engine.StartPondering(opening.board, Stone::WHITE, false);
+  REQUIRE(ponder.IsValid());
+  int reply_x = -1, reply_y = -1;
+  REQUIRE(engine.GetPonderMove(reply_x, reply_y));
+  CAPTURE(reply_x, reply_y);
+  REQUIRE(opening.board[reply_x][reply_y] == Stone::EMPTY);
+  opening.board[reply_x][reply_y] = Stone::WHITE;
+  int x = -1, y = -1;
+  REQUIRE(engine.AlphaBetaGo(opening.board, Stone::BLACK, x, y) == 1);
+  SearchStatistics statistics = engine.GetStatistics();
+  CHECK(statistics.ponder_hit);
+  CHECK(statistics.completed_depth == 3);
+  // the pondering search was the first one of its engine, so a new engine
+  // with the same seed plays the same move
+  Engine fresh;
+  fresh.SetSearchLimits(limits);
+  fresh.SetRandomSeed(1);
+  int fresh_x = -1, fresh_y = -1;
+  REQUIRE(fresh.AlphaBetaGo(opening.board, Stone::BLACK, fresh_x, fresh_y) ==
+          1);
+  CHECK(x == fresh_x);
+  CHECK(y == fresh_y);
+  // the handle is spent once its move is taken
+  CHECK(engine.IsSearchReady(ponder));
+  CHECK_FALSE(engine.GetSearchProgress(ponder).searching);
+}
+
+TEST_CASE("A ponder miss searches the played position from scratch",
+          "[search][ponder]") {
+  Opening opening;
+  SearchLimits limits;
+  limits.max_depth = 3;
+  Engine engine;
+  engine.SetSearchLimits(limits);
+  SearchHandle ponder =
+      engine.StartPondering(opening.board, Stone::WHITE, false);
+  REQUIRE(ponder.IsValid());
+  int reply_x = -1, reply_y = -1;
+  REQUIRE(engine.GetPonderMove(reply_x, reply_y));
+  // the opponent answers somewhere else
+  int played_x = reply_x == 6 && reply_y == 6 ? 9 : 6;
+  int played_y = played_x;
+  REQUIRE(opening.board[played_x][played_y] == Stone::EMPTY);
+  opening.board[played_x][played_y] = Stone::WHITE;
+  int x = -1, y = -1;
+  REQUIRE(engine.AlphaBetaGo(opening.board, Stone::BLACK, x, y) == 1);
+  CAPTURE(x, y);
+  CHECK(opening.board[x][y] == Stone::EMPTY);
+  SearchStatistics statistics = engine.GetStatistics();
+  CHECK_FALSE(statistics.ponder_hit);
+  CHECK(statistics.completed_depth == 3);
+  // the pondering search was stopped and takes no move
+  CHECK_FALSE(engine.GetSearchProgress(ponder).searching);
+  CHECK(engine.TakeSearchResult(ponder, x, y) == 0);
+}
+
+TEST_CASE("The time limit only starts on a ponder hit", "[search][ponder]") {
+  Opening opening;
+  // far too deep to finish, only the deadline ends the search
+  SearchLimits limits;
+  limits.max_depth = 12;
+  limits.time_limit_ms = 100;
+  Engine engine;
+  engine.SetSearchLimits(limits);
+  SearchHandle ponder =
+      engine.StartPondering(opening.board, Stone::WHITE, false);
+  REQUIRE(ponder.IsValid());
+  int reply_x = -1, reply_y = -1;
+  REQUIRE(engine.GetPonderMove(reply_x, reply_y));
+  // pondering goes on past the time limit
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  CHECK_FALSE(engine.IsSearchReady(ponder));
+  CHECK(engine.GetSearchProgress(ponder).pondering);
+  opening.board[reply_x][reply_y] = Stone::WHITE;
+  int x = -1, y = -1;
+  auto start = std::chrono::steady_clock::now();
+  REQUIRE(engine.AlphaBetaGo(opening.board, Stone::BLACK, x, y) == 1);
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  CAPTURE(x, y, elapsed.count());
+  CHECK(opening.board[x][y] == Stone::EMPTY);
+  // the deadline is armed at the hit, not lost while pondering
+  CHECK(elapsed.count() < 5000);
+  SearchStatistics statistics = engine.GetStatistics();
+  CHECK(statistics.ponder_hit);
+  CHECK(statistics.completed_depth > 0);
+  CHECK(statistics.completed_depth < 12);
+}
+
+TEST_CASE("An async search plays the move of a blocking one", "[search]") {
+  Opening opening;
+  SearchLimits limits;
+  limits.max_depth = 3;
+  Engine engine;
+  engine.SetSearchLimits(limits);
+  engine.SetRandomSeed(1);
+  SearchHandle search =
+      engine.AlphaBetaGoAsync(opening.board, Stone::WHITE, false);
+  REQUIRE(search.IsValid());
+  REQUIRE(WaitForSearch(engine, search));
+  SearchProgress progress = engine.GetSearchProgress(search);
+  CHECK(progress.searching);
+  CHECK(progress.done);
+  CHECK_FALSE(progress.pondering);
+  CHECK(progress.completed_depth == 3);
+  CHECK(progress.nodes > 0);
+  int x = -1, y = -1;
+  REQUIRE(engine.TakeSearchResult(search, x, y) == 1);
+  CHECK(x == progress.row_index);
+  CHECK(y == progress.column_index);
+  // the move is taken once
+  CHECK_FALSE(engine.GetSearchProgress(search).searching);
+  CHECK(engine.TakeSearchResult(search, x, y) == 0);
+  Engine blocking;
+  blocking.SetSearchLimits(limits);
+  blocking.SetRandomSeed(1);
+  int blocking_x = -1, blocking_y = -1;
+  REQUIRE(blocking.AlphaBetaGo(opening.board, Stone::WHITE, blocking_x,
+                               blocking_y) == 1);
+  CHECK(x == blocking_x);
+  CHECK(y == blocking_y);
+}
+
+TEST_CASE("A cancelled search plays its last finished iteration",
+          "[search]") {
+  Opening opening;
+  // far too deep to finish, only cancelling ends the search
+  SearchLimits limits;
+  limits.max_depth = 12;
+  Engine engine;
+  engine.SetSearchLimits(limits);
+  SearchHandle search =
+      engine.AlphaBetaGoAsync(opening.board, Stone::WHITE, false);
+  REQUIRE(search.IsValid());
+  SearchProgress progress{};
+  for (int k = 0; k < 1000 && progress.completed_depth == 0; k++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    progress = engine.GetSearchProgress(search);
+  }
+  REQUIRE(progress.completed_depth > 0);
+  CHECK_FALSE(progress.done);
+  engine.CancelSearch(search);
+  REQUIRE(WaitForSearch(engine, search));
+  int x = -1, y = -1;
+  REQUIRE(engine.TakeSearchResult(search, x, y) == 1);
+  CAPTURE(x, y);
+  CHECK(opening.board[x][y] == Stone::EMPTY);
+  SearchStatistics statistics = engine.GetStatistics();
+  CHECK(statistics.completed_depth >= progress.completed_depth);
+  CHECK(statistics.completed_depth < 12);
+}
+
+TEST_CASE("A new search makes the handle of the previous one stale",
+          "[search]") {
+  Opening opening;
+  SearchLimits limits;
+  limits.max_depth = 12;
+  Engine engine;
+  engine.SetSearchLimits(limits);
+  SearchHandle first =
+      engine.AlphaBetaGoAsync(opening.board, Stone::WHITE, false);
+  REQUIRE(first.IsValid());
+  opening.board[6][6] = Stone::WHITE;
+  SearchHandle second =
+      engine.AlphaBetaGoAsync(opening.board, Stone::BLACK, false);
+  REQUIRE(second.IsValid());
+  CHECK(second.id != first.id);
+  // the stale handle is ready, shows no progress and takes no move
+  CHECK(engine.IsSearchReady(first));
+  SearchProgress stale = engine.GetSearchProgress(first);
+  CHECK_FALSE(stale.searching);
+  CHECK(stale.row_index == -1);
+  CHECK(stale.column_index == -1);
+  int x = -1, y = -1;
+  CHECK(engine.TakeSearchResult(first, x, y) == 0);
+  // nor does it stop the search that replaced it
+  engine.CancelSearch(first);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  CHECK_FALSE(engine.IsSearchReady(second));
+  CHECK(engine.GetSearchProgress(second).searching);
+  engine.CancelSearch(second);
+  REQUIRE(WaitForSearch(engine, second));
+  REQUIRE(engine.TakeSearchResult(second, x, y) == 1);
+  CAPTURE(x, y);
+  CHECK(opening.board[x][y] == Stone::EMPTY);
+}
+
+TEST_CASE("Lazy SMP plays the move of the main searcher", "[search][smp]") {
+  Opening opening;
+  SearchLimits limits;
+  limits.max_depth = 3;
+  Engine engine;
+  engine.SetSearchLimits(limits);
+  engine.SetParallelMode(LAZY_SMP);
+  // helpers run even on a single core machine
+  engine.SetThreadNum(4);
+  SearchHandle search =
+      engine.AlphaBetaGoAsync(opening.board, Stone::WHITE, true);
+  REQUIRE(WaitForSearch(engine, search));
+  // only the main searcher reports progress, helpers one level ahead of
+  // it finish their own iterations without reporting
+  SearchProgress progress = engine.GetSearchProgress(search);
+  CHECK(progress.completed_depth == 3);
+  int x = -1, y = -1;
+  REQUIRE(engine.TakeSearchResult(search, x, y) == 1);
+  CHECK(x == progress.row_index);
+  CHECK(y == progress.column_index);
+  SearchStatistics statistics = engine.GetStatistics();
+  CHECK(statistics.completed_depth == 3);
+  CHECK(statistics.best_value == progress.best_value);
+}
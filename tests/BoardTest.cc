@@ -2,3 +2,110 @@
 // Created by yj17 on 4/19/2020.
 //
 #define CATCH_CONFIG_MAIN
+#include <mylibrary/BitBoard.h>
+#include <mylibrary/Game.h>
+
+#include <catch2/catch.hpp>
+#include <random>
+
+namespace {
+/**
+ * check five in a row through a stone by walking the grids one by one
+ * @tparam N board size
+ * @tparam K number of stones in a row to win
+ * @return whether the stone at given position wins
+ */
+template <int N, int K>
+bool IsWinByWalking(Stone board[N][N], int x, int y) {
+  Stone stone = board[x][y];
+  if (stone == Stone::EMPTY) return false;
+  const int dx[4] = {0, 1, 1, 1};
+  const int dy[4] = {1, 0, 1, -1};
+  for (int dir = 0; dir < 4; dir++) {
+    int count = 1;
+    for (int sign = -1; sign <= 1; sign += 2) {
+      int new_x = x + sign * dx[dir], new_y = y + sign * dy[dir];
+      while (new_x >= 0 && new_x < N && new_y >= 0 && new_y < N &&
+             board[new_x][new_y] == stone) {
+        count++;
+        new_x += sign * dx[dir];
+        new_y += sign * dy[dir];
+      }
+    }
+    if (count >= K) return true;
+  }
+  return false;
+}
+}  // namespace
+
+TEMPLATE_TEST_CASE_SIG("Bitboard win check agrees with walking the board",
+                       "[board]", ((int N, int K), N, K), (19, 5), (15, 5),
+                       (9, 5)) {
+  // fill random boards and compare the check of every grid
+  const unsigned seed = static_cast<unsigned>(N);
+  CAPTURE(N, K, seed);
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<int> pick(0, 2);
+  for (int round = 0; round < 200; round++) {
+    Stone board[N][N];
+    for (int x = 0; x < N; x++)
+      for (int y = 0; y < N; y++)
+        board[x][y] = static_cast<Stone>(pick(random));
+    BasicBitBoard<N, K> bits(board);
+    for (int x = 0; x < N; x++) {
+      for (int y = 0; y < N; y++) {
+        CAPTURE(round, x, y);
+        REQUIRE(bits.Get(x, y) == board[x][y]);
+        REQUIRE(bits.IsWin(x, y) == IsWinByWalking<N, K>(board, x, y));
+      }
+    }
+  }
+}
+
+TEST_CASE("Five in a row wins in every direction", "[board]") {
+  // start of the row and step between its stones
+  const int lines[][4] = {{0, 14, 0, 1},  // row at the right edge
+                          {14, 3, 1, 0},  // column at the bottom edge
+                          {0, 0, 1, 1},   // diagonal from the corner
+                          {4, 18, 1, -1}};  // anti-diagonal at the edge
+  for (const auto& line : lines) {
+    BasicBitBoard<19, 5> bits;
+    for (int k = 0; k < 4; k++)
+      bits.Place(line[0] + k * line[2], line[1] + k * line[3], Stone::WHITE);
+    REQUIRE_FALSE(bits.IsWin(line[0], line[1]));
+    bits.Place(line[0] + 4 * line[2], line[1] + 4 * line[3], Stone::WHITE);
+    for (int k = 0; k < 5; k++)
+      REQUIRE(bits.IsWin(line[0] + k * line[2], line[1] + k * line[3]));
+    // taking a stone back breaks the row
+    bits.Remove(line[0] + 2 * line[2], line[1] + 2 * line[3], Stone::WHITE);
+    REQUIRE_FALSE(bits.IsWin(line[0], line[1]));
+  }
+}
+
+TEST_CASE("Game ends when five in a row is played", "[board]") {
+  Game game;
+  // black plays row 9, white row 10
+  for (int k = 0; k < 4; k++) {
+    REQUIRE(game.Play(9, 5 + k) == Stone::EMPTY);
+    REQUIRE(game.Play(10, 5 + k) == Stone::EMPTY);
+  }
+  REQUIRE(game.Play(9, 9) == Stone::BLACK);
+  REQUIRE(game.GetRole() == Stone::EMPTY);
+}
+
+TEST_CASE("Neighbors are the empty grids near stones", "[board]") {
+  BasicBitBoard<9, 5> bits;
+  bits.Place(0, 0, Stone::BLACK);
+  bits.Place(4, 4, Stone::WHITE);
+  uint32_t neighbors[9];
+  bits.GetNeighbors(1, neighbors);
+  for (int x = 0; x < 9; x++) {
+    for (int y = 0; y < 9; y++) {
+      bool near = (x <= 1 && y <= 1) || (x >= 3 && x <= 5 && y >= 3 && y <= 5);
+      bool empty = bits.Get(x, y) == Stone::EMPTY;
+      REQUIRE(((neighbors[x] >> static_cast<unsigned>(y)) & 1U) ==
+              (near && empty ? 1U : 0U));
+      REQUIRE(bits.HasNeighbor(x, y, 1) == near);
+    }
+  }
+}
@@ -0,0 +1,51 @@
+//
+// Tests of candidate moves maintained during search.
+//
+
+#include <mylibrary/BitBoard.h>
+#include <mylibrary/CandidateSet.h>
+
+#include <catch2/catch.hpp>
+#include <random>
+
+TEMPLATE_TEST_CASE_SIG("Candidate set follows a random walk of moves",
+                       "[candidates]", ((int N), N), 19, 15, 9) {
+  const int range = GENERATE(1, 2);
+  CAPTURE(N, range);
+  std::mt19937 random(static_cast<unsigned>(N * 10 + range));
+  std::uniform_int_distribution<int> pick_grid(0, N * N - 1);
+  Stone board[N][N] = {};
+  BasicBitBoard<N, 5> bits;
+  BasicCandidateSet<N> candidates;
+  candidates.Init(board, range);
+  for (int step = 0; step < 2000; step++) {
+    // play on an empty grid or take a stone back, in any order. About half
+    // of the board ends up occupied
+    int grid = pick_grid(random);
+    int x = grid / N, y = grid % N;
+    bool place = board[x][y] == Stone::EMPTY;
+    if (place) {
+      board[x][y] = step % 2 == 0 ? Stone::BLACK : Stone::WHITE;
+      bits.Place(x, y, board[x][y]);
+      candidates.Place(x, y);
+    } else {
+      bits.Remove(x, y, board[x][y]);
+      board[x][y] = Stone::EMPTY;
+      candidates.Remove(x, y);
+    }
+    CAPTURE(step, place, x, y);
+    uint32_t neighbors[N];
+    bits.GetNeighbors(range, neighbors);
+    for (int row = 0; row < N; row++) {
+      CAPTURE(row);
+      REQUIRE(candidates.GetRow(row) == neighbors[row]);
+    }
+  }
+  // a set built from the final board agrees with the updated one
+  BasicCandidateSet<N> rebuilt;
+  rebuilt.Init(board, range);
+  for (int row = 0; row < N; row++) {
+    CAPTURE(row);
+    REQUIRE(rebuilt.GetRow(row) == candidates.GetRow(row));
+  }
+}
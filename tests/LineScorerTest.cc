@@ -0,0 +1,139 @@
+//
+// Tests of board line scoring.
+//
+
+#include <mylibrary/LineScorer.h>
+
+#include <catch2/catch.hpp>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+/**
+ * get the lines through a grid, like the search does when a stone is placed
+ * @tparam N board size
+ * @param x row index
+ * @param y column index
+ * @param lines line indices, one for each direction
+ */
+template <int N>
+void GetLinesThrough(int x, int y, int lines[4]) {
+  const int* offset = BasicLineScorer<N>::LINE_OFFSET;
+  lines[0] = offset[0] + y;
+  lines[1] = offset[1] + x;
+  lines[2] = offset[2] + ((x >= y) ? x - y : N - 1 + y - x);
+  lines[3] = offset[3] + ((x + y > N - 1) ? x + y : N - 1 - x - y);
+}
+
+/**
+ * @return whether both scores hold the same line scores and types
+ */
+template <int N>
+bool IsSameScores(const typename BasicLineScorer<N>::Scores& a,
+                  const typename BasicLineScorer<N>::Scores& b) {
+  return memcmp(a.score, b.score, sizeof(a.score)) == 0 &&
+         memcmp(a.type, b.type, sizeof(a.type)) == 0;
+}
+
+/**
+ * play random games, scoring only the lines through each placed stone and
+ * putting them back when the stone is taken, and compare with scoring the
+ * whole board
+ * @tparam N board size
+ * @return whether every incremental score equals the full score
+ */
+template <int N>
+bool IsIncrementalScoreExact() {
+  using LineScorer = BasicLineScorer<N>;
+  std::mt19937 random(N);
+  for (int game = 0; game < 20; game++) {
+    Stone board[N][N] = {};
+    typename LineScorer::Scores incremental, full;
+    LineScorer::ScoreBoard(board, &incremental);
+    // scores of the lines before each move
+    std::vector<typename LineScorer::Scores> saved;
+    std::vector<int> moves;
+    std::uniform_int_distribution<int> pick(0, N * N - 1);
+    Stone player = Stone::BLACK;
+    for (int ply = 0; ply < N * N / 2; ply++) {
+      int grid = pick(random);
+      int x = grid / N, y = grid % N;
+      if (board[x][y] != Stone::EMPTY) continue;
+      saved.push_back(incremental);
+      moves.push_back(grid);
+      board[x][y] = player;
+      int lines[4];
+      GetLinesThrough<N>(x, y, lines);
+      LineScorer::ScoreLines(board, lines, 4, &incremental);
+      LineScorer::ScoreBoard(board, &full);
+      if (!IsSameScores<N>(incremental, full)) return false;
+      player = player == Stone::BLACK ? Stone::WHITE : Stone::BLACK;
+    }
+    // take the stones back in reverse order
+    while (!moves.empty()) {
+      board[moves.back() / N][moves.back() % N] = Stone::EMPTY;
+      incremental = saved.back();
+      moves.pop_back();
+      saved.pop_back();
+      LineScorer::ScoreBoard(board, &full);
+      if (!IsSameScores<N>(incremental, full)) return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * score random boards with the vector kernel and with the scalar scan
+ * @tparam N board size
+ * @return whether both give the same scores
+ */
+template <int N>
+bool IsVectorScoreExact() {
+  using LineScorer = BasicLineScorer<N>;
+  std::mt19937 random(N + 1);
+  std::uniform_int_distribution<int> pick(0, 3);
+  std::uniform_int_distribution<int> pick_line(0, LineScorer::LINE_NUM - 1);
+  bool same = true;
+  for (int round = 0; round < 50 && same; round++) {
+    // mostly empty boards early, crowded boards later
+    Stone board[N][N];
+    for (int x = 0; x < N; x++)
+      for (int y = 0; y < N; y++)
+        board[x][y] = pick(random) * 50 < round * 3
+                          ? static_cast<Stone>(pick(random) % 2 + 1)
+                          : Stone::EMPTY;
+    typename LineScorer::Scores vector = {}, scalar = {};
+    LineScorer::SetScalar(false);
+    LineScorer::ScoreBoard(board, &vector);
+    LineScorer::SetScalar(true);
+    LineScorer::ScoreBoard(board, &scalar);
+    same = IsSameScores<N>(vector, scalar);
+    // a group of 8 lines and 3 left over for the scalar scan
+    int lines[11];
+    for (int& line : lines) line = pick_line(random);
+    LineScorer::SetScalar(false);
+    LineScorer::ScoreLines(board, lines, 11, &vector);
+    LineScorer::SetScalar(true);
+    LineScorer::ScoreLines(board, lines, 11, &scalar);
+    same = same && IsSameScores<N>(vector, scalar);
+  }
+  LineScorer::SetScalar(false);
+  return same;
+}
+}  // namespace
+
+TEST_CASE("Scoring lines through the move equals a full rescore",
+          "[line scorer]") {
+  SECTION("Standard board") { REQUIRE(IsIncrementalScoreExact<19>()); }
+  SECTION("Small board") { REQUIRE(IsIncrementalScoreExact<9>()); }
+}
+
+TEST_CASE("Vector kernel scores lines like the scalar scan",
+          "[line scorer]") {
+  // without AVX2 both sides run the scalar scan
+  INFO("vectorized: " << LineScorer::IsVectorized());
+  SECTION("Standard board") { REQUIRE(IsVectorScoreExact<19>()); }
+  SECTION("Gomoku board") { REQUIRE(IsVectorScoreExact<15>()); }
+  SECTION("Small board") { REQUIRE(IsVectorScoreExact<9>()); }
+}
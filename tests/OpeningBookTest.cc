@@ -0,0 +1,61 @@
+//
+// Tests of the opening book file.
+//
+
+#include <mylibrary/OpeningBook.h>
+
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+// book file written by the tests
+const char BOOK_PATH[] = "opening_book_test.book";
+
+/**
+ * write a book with the move of a single stone at the center
+ * @tparam N board size
+ * @param x row index reference, updated to the book move
+ * @param y column index reference, updated to the book move
+ * @return whether the file is written
+ */
+template <int N>
+bool WriteCenterBook(int& x, int& y) {
+  Stone board[N][N] = {};
+  board[N / 2][N / 2] = Stone::BLACK;
+  int symmetry;
+  BookEntry entry{};
+  entry.key = OpeningBook::GetKey(board, Stone::WHITE, symmetry);
+  int book_x, book_y;
+  x = N / 2;
+  y = N / 2 + 1;
+  BasicZobrist<N>::Transform(symmetry, x, y, book_x, book_y);
+  entry.row_index = static_cast<uint8_t>(book_x);
+  entry.column_index = static_cast<uint8_t>(book_y);
+  return OpeningBook::Write(BOOK_PATH, std::vector<BookEntry>{entry}, N, 5);
+}
+}  // namespace
+
+TEST_CASE("Book only opens on the board it is built for", "[book]") {
+  int x, y;
+  REQUIRE(WriteCenterBook<15>(x, y));
+  OpeningBook book;
+  REQUIRE_FALSE(book.Open(BOOK_PATH, 19, 5));
+  REQUIRE_FALSE(book.Open(BOOK_PATH, 15, 6));
+  REQUIRE(book.Open(BOOK_PATH, 15, 5));
+  REQUIRE(book.GetSize() == 1);
+
+  Stone board[15][15] = {};
+  board[7][7] = Stone::BLACK;
+  int book_x = -1, book_y = -1;
+  REQUIRE(book.Probe<15>(board, Stone::WHITE, book_x, book_y));
+  REQUIRE(book_x == x);
+  REQUIRE(book_y == y);
+  // positions of another board size are never found
+  Stone other[19][19] = {};
+  other[9][9] = Stone::BLACK;
+  REQUIRE_FALSE(book.Probe<19>(other, Stone::WHITE, book_x, book_y));
+  book.Close();
+  std::remove(BOOK_PATH);
+}
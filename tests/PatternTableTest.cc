@@ -0,0 +1,103 @@
+//
+// Tests of the pattern table.
+//
+
+#include <mylibrary/PatternTable.h>
+
+#include <catch2/catch.hpp>
+#include <cstring>
+#include <vector>
+
+namespace {
+/**
+ * check whether an address contains a mask at any grid, the way the
+ * table was filled at run time before it was generated at compile time
+ * @param addr line address
+ * @param addr_bit_count number of bits of the address
+ * @param mask pattern mask
+ * @param mask_bit_count number of bits of the mask
+ * @return whether the address contains the mask
+ */
+bool IsAddrContainsMask(int addr, int addr_bit_count, int mask,
+                        int mask_bit_count) {
+  int k = 0;
+  for (int i = 0; i < mask_bit_count; i++) k |= 1 << i;  // NOLINT
+  for (int i = mask_bit_count; i <= addr_bit_count; i += 2) {
+    if ((addr & k) == mask) return true;  // NOLINT
+    mask <<= 2;                           // NOLINT
+    k <<= 2;                              // NOLINT
+  }
+  return false;
+}
+
+/**
+ * fill score and type tables by checking every address against every
+ * pattern
+ * @param scores score of every address
+ * @param types pattern type of every address
+ */
+void MakeTablesByScan(std::vector<int>& scores, std::vector<int>& types) {
+  scores.assign(BIT_DATA_SIZE, 0);
+  types.assign(BIT_DATA_SIZE, 0);
+  for (const Pattern& pattern : PATTERNS) {
+    int forward = 0, backward = 0;
+    int length = static_cast<int>(strlen(pattern.string_pattern));
+    for (int j = 0; j < length; j++) {
+      forward <<= 2;   // NOLINT
+      backward <<= 2;  // NOLINT
+      char grid = pattern.string_pattern[j];
+      if (grid == '1') forward |= 1;  // NOLINT
+      if (grid == '2') forward |= 2;  // NOLINT
+      grid = pattern.string_pattern[length - j - 1];
+      if (grid == '1') backward |= 1;  // NOLINT
+      if (grid == '2') backward |= 2;  // NOLINT
+    }
+    for (int addr = 0; addr < BIT_DATA_SIZE; addr++) {
+      if (scores[addr] != 0) continue;
+      if (IsAddrContainsMask(addr, BIT_DATA_LENGTH, forward, length * 2) ||
+          IsAddrContainsMask(addr, BIT_DATA_LENGTH, backward, length * 2)) {
+        scores[addr] = pattern.score;
+        types[addr] = pattern.type;
+      }
+    }
+  }
+}
+}  // namespace
+
+TEST_CASE("Compile-time table equals scanning every address", "[pattern]") {
+  std::vector<int> scores, types;
+  MakeTablesByScan(scores, types);
+  int mismatches = 0;
+  for (int addr = 0; addr < BIT_DATA_SIZE; addr++) {
+    if (GetPatternScore(PATTERN_TABLE.entry[addr]) != scores[addr] ||
+        GetPatternType(PATTERN_TABLE.entry[addr]) != types[addr])
+      mismatches++;
+  }
+  REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("Known lines get their pattern", "[pattern]") {
+  // seven grids, the first in the highest bits: 1 for the player, 2 for
+  // the opponent or the edge
+  const int open_four = 0x0154;    // 0011110
+  const int closed_four = 0x0956;  // 0211112
+  const int five = 0x0155;         // 0011111
+  REQUIRE(GetPatternType(PATTERN_TABLE.entry[open_four]) == OPEN_FOUR);
+  REQUIRE(GetPatternType(PATTERN_TABLE.entry[closed_four]) == CLOSE_FOUR);
+  REQUIRE(GetPatternType(PATTERN_TABLE.entry[five]) == CONSECUTIVE_FIVE);
+  REQUIRE(GetPatternScore(PATTERN_TABLE.entry[five]) == 1000000);
+  REQUIRE(PATTERN_TABLE.entry[0] == 0);
+}
+
+TEST_CASE("Packed entries give back score and type", "[pattern]") {
+  for (const Pattern& pattern : PATTERNS) {
+    uint32_t entry = PackPattern(pattern.score, pattern.type);
+    REQUIRE(GetPatternScore(entry) == pattern.score);
+    REQUIRE(GetPatternType(entry) == pattern.type);
+  }
+  // every type fits the type bits
+  REQUIRE(CLOSE_TWO < 1 << PATTERN_TYPE_BITS);  // NOLINT
+  REQUIRE(GetPatternType(PackPattern(0, CLOSE_TWO)) == CLOSE_TWO);
+  static_assert(GetPatternScore(PackPattern(1000000, OPEN_FOUR)) == 1000000,
+                "entries are not unpacked at compile time");
+}
@@ -0,0 +1,178 @@
+//
+// Tests of the alpha-beta search.
+//
+
+#include <mylibrary/SearchEngine.h>
+
+#include <catch2/catch.hpp>
+#include <vector>
+
+namespace {
+/**
+ * 9x9 board filled up to two empty grids, (2, 0) and (8, 8). Neither
+ * player makes five on it, whichever grid is played. X is black, O is
+ * white, and white is to move
+ */
+const char* const FULL_BOARD[9] = {
+    "XXOXXOXXX", "XOXOXXOXO", ".OOXOXXXO", "OOOXOOXOO", "OXOXOOXOX",
+    "XOXXOXOXO", "XXXOXXOXO", "XOXXOXXOO", "OOOXXOOO."};
+
+/**
+ * 15x15 board of a middle game, black to move. Neither player has a win
+ * by threats, so it is searched in full
+ */
+const char* const MIDDLE_GAME[15] = {
+    "...............", "...............", "...............",
+    "...............", "...............", ".....O.X.......",
+    "......O........", ".....O.X.......", "....OO..X......",
+    ".......X.X.....", "..........X....", "...........O...",
+    "...............", "...............", "..............."};
+
+/**
+ * @tparam N board size
+ * @param rows rows of the board, X for black, O for white, . for empty
+ * @param board board reference, in row order
+ */
+template <int N>
+void ReadBoard(const char* const rows[N], Stone board[N * N]) {
+  for (int x = 0; x < N; x++)
+    for (int y = 0; y < N; y++)
+      board[x * N + y] = rows[x][y] == 'X'   ? Stone::BLACK
+                         : rows[x][y] == 'O' ? Stone::WHITE
+                                             : Stone::EMPTY;
+}
+}  // namespace
+
+TEST_CASE("A board that fills up is searched as a draw", "[search]") {
+  Stone board[9 * 9];
+  ReadBoard<9>(FULL_BOARD, board);
+  std::unique_ptr<SearchEngine> engine = CreateSearchEngine(9, 5);
+  REQUIRE(engine != nullptr);
+  // deeper than the board has moves left, the later iterations start
+  // their aspiration window from the score of the full board
+  SearchLimits limits;
+  limits.max_depth = 6;
+  engine->SetSearchLimits(limits);
+  int x = -1, y = -1;
+  REQUIRE(engine->AlphaBetaGo(board, Stone::WHITE, x, y) == 1);
+  CAPTURE(x, y);
+  CHECK(((x == 2 && y == 0) || (x == 8 && y == 8)));
+  SearchStatistics statistics = engine->GetStatistics();
+  CHECK(statistics.completed_depth == 6);
+  CHECK(statistics.best_value == 0);
+}
+
+TEST_CASE("Null windows do not change the root score", "[search]") {
+  Stone board[15][15];
+  ReadBoard<15>(MIDDLE_GAME, &board[0][0]);
+  // the leaf threat probe and quiescence spend node budgets, so their
+  // scores depend on the order nodes are visited in. Without them, and
+  // without pruning, both searches find the minimax score
+  SearchLimits limits;
+  limits.max_depth = 3;
+  limits.quiescence_depth = 0;
+  PruningOptions pruning;
+  pruning.late_move_reduction = false;
+  pruning.futility_pruning = false;
+  SearchStatistics statistics[2];
+  for (int pvs = 0; pvs < 2; pvs++) {
+    BasicAlphaBetaAlgorithm<15, 5> engine;
+    engine.SetSearchLimits(limits);
+    engine.SetPruningOptions(pruning);
+    engine.SetThreatProbe(false);
+    engine.SetPrincipalVariationSearch(pvs == 1);
+    int x = -1, y = -1;
+    REQUIRE(engine.AlphaBetaGo(board, Stone::BLACK, x, y) == 1);
+    statistics[pvs] = engine.GetStatistics();
+    REQUIRE(statistics[pvs].completed_depth == 3);
+  }
+  CHECK(statistics[1].best_value == statistics[0].best_value);
+}
+
+namespace {
+/**
+ * search the middle game within a budget, then search it again to the
+ * depth the budget reached with a new engine
+ * @param limits budget, deeper than it can reach
+ */
+void CheckLastIterationPlayed(const SearchLimits& limits) {
+  Stone board[15][15];
+  ReadBoard<15>(MIDDLE_GAME, &board[0][0]);
+  // the threat solver of the leaf probe keeps its cache from one search
+  // to the next, so it would answer the second search differently
+  BasicAlphaBetaAlgorithm<15, 5> engine;
+  engine.SetSearchLimits(limits);
+  engine.SetThreatProbe(false);
+  engine.SetRandomSeed(1);
+  int x = -1, y = -1;
+  REQUIRE(engine.AlphaBetaGo(board, Stone::BLACK, x, y) == 1);
+  SearchStatistics statistics = engine.GetStatistics();
+  CAPTURE(statistics.completed_depth, statistics.nodes);
+  REQUIRE(statistics.completed_depth > 0);
+  REQUIRE(statistics.completed_depth < limits.max_depth);
+  // the unfinished iteration is discarded, so the move and score are
+  // those of a search stopping after the last finished one
+  SearchLimits depth_limits;
+  depth_limits.max_depth = statistics.completed_depth;
+  BasicAlphaBetaAlgorithm<15, 5> complete;
+  complete.SetSearchLimits(depth_limits);
+  complete.SetThreatProbe(false);
+  complete.SetRandomSeed(1);
+  int complete_x = -1, complete_y = -1;
+  REQUIRE(complete.AlphaBetaGo(board, Stone::BLACK, complete_x,
+                               complete_y) == 1);
+  CHECK(x == complete_x);
+  CHECK(y == complete_y);
+  CHECK(statistics.best_value == complete.GetStatistics().best_value);
+}
+}  // namespace
+
+TEST_CASE("A node limit stops the search after its last iteration",
+          "[search]") {
+  SearchLimits limits;
+  limits.max_depth = 12;
+  limits.node_limit = 20000;
+  CheckLastIterationPlayed(limits);
+}
+
+TEST_CASE("A time limit stops the search after its last iteration",
+          "[search]") {
+  SearchLimits limits;
+  limits.max_depth = 12;
+  limits.time_limit_ms = 200;
+  CheckLastIterationPlayed(limits);
+}
+
+TEST_CASE("Only instantiated board variants have an engine", "[search]") {
+  CHECK(CreateSearchEngine(13, 5) == nullptr);
+  CHECK(CreateSearchEngine(15, 6) == nullptr);
+  CHECK(CreateSearchEngine(19, 4) == nullptr);
+  CHECK(CreateSearchEngine(0, 0) == nullptr);
+}
+
+TEST_CASE("Every board variant plays a legal move", "[search]") {
+  const int size = GENERATE(9, 15, 19);
+  CAPTURE(size);
+  std::unique_ptr<SearchEngine> engine = CreateSearchEngine(size, 5);
+  REQUIRE(engine != nullptr);
+  CHECK(engine->GetBoardSize() == size);
+  CHECK(engine->GetWinLength() == 5);
+  SearchLimits limits;
+  limits.max_depth = 2;
+  engine->SetSearchLimits(limits);
+  // black opens in the center and on the edge, white is to move
+  std::vector<Stone> board(static_cast<size_t>(size * size), Stone::EMPTY);
+  int center = size / 2;
+  board[static_cast<size_t>(center * size + center)] = Stone::BLACK;
+  board[static_cast<size_t>(size - 1)] = Stone::BLACK;
+  board[static_cast<size_t>(center * size + center + 1)] = Stone::WHITE;
+  int x = -1, y = -1;
+  REQUIRE(engine->AlphaBetaGo(board.data(), Stone::WHITE, x, y) == 1);
+  CAPTURE(x, y);
+  REQUIRE(x >= 0);
+  REQUIRE(x < size);
+  REQUIRE(y >= 0);
+  REQUIRE(y < size);
+  CHECK(board[static_cast<size_t>(x * size + y)] == Stone::EMPTY);
+  CHECK(engine->GetStatistics().completed_depth == 2);
+}
@@ -0,0 +1,124 @@
+//
+// Tests of the work-stealing thread pool.
+//
+
+#include <mylibrary/ThreadPool.h>
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <thread>
+
+namespace {
+/**
+ * spin until a flag is set or ten seconds pass
+ * @param flag flag to wait for
+ * @return whether the flag is set
+ */
+bool WaitForFlag(const std::atomic<bool>& flag) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!flag.load()) {
+    if (std::chrono::steady_clock::now() > deadline) return false;
+    std::this_thread::yield();
+  }
+  return true;
+}
+}  // namespace
+
+TEST_CASE("Wait returns once every submitted task has run", "[pool]") {
+  ThreadPool pool(4);
+  REQUIRE(pool.GetThreadNum() == 4);
+  std::atomic<int> count(0);
+  TaskGroup group;
+  for (int k = 0; k < 1000; k++) pool.Submit(group, [&count] { count++; });
+  pool.Wait(group);
+  CHECK(group.IsDone());
+  CHECK(count.load() == 1000);
+  // an empty group is done at once
+  TaskGroup empty;
+  pool.Wait(empty);
+  CHECK(empty.IsDone());
+}
+
+TEST_CASE("Idle workers steal tasks queued by a busy worker", "[pool]") {
+  ThreadPool pool(4);
+  const int task_num = 16;
+  std::atomic<int> stolen(0);
+  std::atomic<bool> all_stolen(false);
+  bool owner_ran_any = false;
+  TaskGroup outer, inner;
+  pool.Submit(outer, [&] {
+    std::thread::id owner = std::this_thread::get_id();
+    // tasks submitted from a worker go to its own queue
+    for (int k = 0; k < task_num; k++) {
+      pool.Submit(inner, [&, owner] {
+        if (std::this_thread::get_id() == owner) return;
+        if (++stolen == task_num) all_stolen.store(true);
+      });
+    }
+    // the owner stays busy, only other workers can run the tasks
+    owner_ran_any = !WaitForFlag(all_stolen);
+  });
+  // this thread does not help before the tasks are taken
+  REQUIRE(WaitForFlag(all_stolen));
+  pool.Wait(outer);
+  pool.Wait(inner);
+  CHECK_FALSE(owner_ran_any);
+  CHECK(stolen.load() == task_num);
+}
+
+TEST_CASE("A waiting thread runs queued tasks itself", "[pool]") {
+  // one worker, so nested waits only finish if the waiting thread helps
+  ThreadPool pool(1);
+  SECTION("Wait inside a task") {
+    std::atomic<int> count(0);
+    bool same_thread = true;
+    TaskGroup outer;
+    pool.Submit(outer, [&] {
+      std::thread::id worker = std::this_thread::get_id();
+      TaskGroup inner;
+      for (int k = 0; k < 8; k++) {
+        pool.Submit(inner, [&, worker] {
+          if (std::this_thread::get_id() != worker) same_thread = false;
+          count++;
+        });
+      }
+      pool.Wait(inner);
+    });
+    pool.Wait(outer);
+    CHECK(count.load() == 8);
+    CHECK(same_thread);
+  }
+  SECTION("Wait outside the pool while the worker is busy") {
+    std::atomic<bool> blocking(false), release(false);
+    TaskGroup busy, group;
+    pool.Submit(busy, [&] {
+      blocking.store(true);
+      WaitForFlag(release);
+    });
+    REQUIRE(WaitForFlag(blocking));
+    std::thread::id runner;
+    pool.Submit(group, [&runner] { runner = std::this_thread::get_id(); });
+    pool.Wait(group);
+    CHECK(runner == std::this_thread::get_id());
+    release.store(true);
+    pool.Wait(busy);
+  }
+}
+
+TEST_CASE("Destroying the pool finishes queued tasks", "[pool]") {
+  std::atomic<int> count(0);
+  // the group outlives the pool, its tasks count it down
+  TaskGroup group;
+  {
+    ThreadPool pool(2);
+    for (int k = 0; k < 200; k++) {
+      pool.Submit(group, [&count] {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        count++;
+      });
+    }
+  }
+  CHECK(count.load() == 200);
+  CHECK(group.IsDone());
+}
@@ -0,0 +1,136 @@
+//
+// Tests of the threat space solver.
+//
+
+#include <mylibrary/ThreatSolver.h>
+
+#include <catch2/catch.hpp>
+
+namespace {
+using ThreatSolver = BasicThreatSolver<19, 5>;
+
+/**
+ * standard board with given stones
+ */
+struct Position {
+  Stone board[19][19] = {};
+  /**
+   * @param stones grids of the stones, x and y each
+   * @param num number of stones
+   * @param stone stone type
+   */
+  void Place(const int stones[][2], int num, Stone stone) {
+    for (int k = 0; k < num; k++) board[stones[k][0]][stones[k][1]] = stone;
+  }
+};
+
+// black wins by two fours: making a four on row 9 or row 8, then a double
+// four through (8, 12) or (9, 12). No single move makes a double four
+const int VCF_BLACK[][2] = {{9, 9}, {9, 10}, {9, 11}, {8, 9},
+                            {8, 10}, {8, 11}, {10, 12}, {11, 12}};
+const int VCF_WHITE[][2] = {{9, 8}, {8, 8}, {12, 12}, {0, 0}, {0, 18},
+                            {18, 0}, {18, 18}, {17, 1}};
+}  // namespace
+
+TEST_CASE("Victory by continuous fours is found and wins", "[threat]") {
+  Position position;
+  position.Place(VCF_BLACK, 8, Stone::BLACK);
+  position.Place(VCF_WHITE, 8, Stone::WHITE);
+  ThreatSolver solver;
+  int x = -1, y = -1;
+  REQUIRE_FALSE(solver.SolveVcf(position.board, Stone::WHITE, x, y));
+  // play the sequence out, white blocks every four
+  Stone winner = Stone::EMPTY;
+  int black_moves = 0;
+  for (int ply = 0; ply < 8 && winner == Stone::EMPTY; ply++) {
+    black_moves++;
+    REQUIRE(solver.SolveVcf(position.board, Stone::BLACK, x, y));
+    REQUIRE(position.board[x][y] == Stone::EMPTY);
+    position.board[x][y] = Stone::BLACK;
+    if (ThreatSolver::BitBoard(position.board).IsWin(x, y)) {
+      winner = Stone::BLACK;
+      break;
+    }
+    // every black move is a four, white has nothing better than a block
+    REQUIRE_FALSE(
+        ThreatSolver::FindFiveMove(position.board, Stone::WHITE, x, y));
+    REQUIRE(ThreatSolver::FindFiveMove(position.board, Stone::BLACK, x, y));
+    position.board[x][y] = Stone::WHITE;
+  }
+  REQUIRE(winner == Stone::BLACK);
+  // a four, the double four and five in a row
+  REQUIRE(black_moves == 3);
+}
+
+TEST_CASE("No victory by continuous fours without fours", "[threat]") {
+  Position position;
+  const int black[][2] = {{9, 9}, {9, 10}, {10, 11}, {11, 11}};
+  const int white[][2] = {{10, 10}};
+  position.Place(black, 4, Stone::BLACK);
+  position.Place(white, 1, Stone::WHITE);
+  ThreatSolver solver;
+  int x, y;
+  REQUIRE_FALSE(solver.SolveVcf(position.board, Stone::BLACK, x, y));
+  REQUIRE_FALSE(solver.SolveVcf(position.board, Stone::WHITE, x, y));
+}
+
+TEST_CASE("Blocked four is not a victory", "[threat]") {
+  Position position;
+  // black four closed at both ends of row 9 has no grid left
+  const int black[][2] = {{9, 9}, {9, 10}, {9, 11}, {9, 12}};
+  const int white[][2] = {{9, 8}, {9, 13}};
+  position.Place(black, 4, Stone::BLACK);
+  position.Place(white, 2, Stone::WHITE);
+  ThreatSolver solver;
+  int x, y;
+  REQUIRE_FALSE(ThreatSolver::FindFiveMove(position.board, Stone::BLACK, x, y));
+  REQUIRE_FALSE(solver.SolveVcf(position.board, Stone::BLACK, x, y));
+}
+
+TEST_CASE("Victory by continuous threats needs the depth", "[threat]") {
+  Position position;
+  // black (9, 11) makes two open threes, row 9 and column 11
+  const int black[][2] = {{9, 9}, {9, 10}, {10, 11}, {11, 11}};
+  const int white[][2] = {{0, 0}, {0, 18}, {18, 0}, {18, 18}};
+  position.Place(black, 4, Stone::BLACK);
+  position.Place(white, 4, Stone::WHITE);
+  ThreatLimits limits;
+  limits.time_limit_ms = 0;
+  int x = -1, y = -1;
+
+  SECTION("Found with a double three") {
+    ThreatSolver solver;
+    REQUIRE_FALSE(solver.SolveVcf(position.board, Stone::BLACK, x, y));
+    // the double three, then an open four after any block
+    limits.max_depth = 1;
+    REQUIRE(solver.SolveVct(position.board, Stone::BLACK, limits, x, y));
+    REQUIRE(position.board[x][y] == Stone::EMPTY);
+    REQUIRE_FALSE(solver.SolveVct(position.board, Stone::WHITE, limits, x, y));
+  }
+
+  SECTION("Not found when the depth or the nodes run out") {
+    ThreatSolver solver;
+    // only fours are read
+    limits.max_depth = 0;
+    REQUIRE_FALSE(solver.SolveVct(position.board, Stone::BLACK, limits, x, y));
+    limits.max_depth = 1;
+    limits.node_limit = 1;
+    REQUIRE_FALSE(solver.SolveVct(position.board, Stone::BLACK, limits, x, y));
+  }
+}
+
+TEST_CASE("Counter four refutes a single open three", "[threat]") {
+  Position position;
+  // black makes an open three on row 9, white answers with a four on row
+  // 5 and then blocks. Black has nothing else
+  const int black[][2] = {{9, 9}, {9, 10}, {15, 15}};
+  const int white[][2] = {{5, 5}, {5, 6}, {5, 7}, {4, 4}};
+  position.Place(black, 3, Stone::BLACK);
+  position.Place(white, 4, Stone::WHITE);
+  ThreatLimits limits;
+  limits.time_limit_ms = 0;
+  limits.max_depth = 2;
+  ThreatSolver solver;
+  int x, y;
+  REQUIRE_FALSE(solver.SolveVct(position.board, Stone::BLACK, limits, x, y));
+}
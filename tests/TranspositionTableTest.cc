@@ -0,0 +1,63 @@
+//
+// Tests of the transposition table.
+//
+
+#include <mylibrary/TranspositionTable.h>
+
+#include <catch2/catch.hpp>
+#include <climits>
+
+TEST_CASE("Stored entries are read back unchanged", "[transposition]") {
+  TranspositionTable table(1024);
+  TranspositionEntry entry{};
+
+  SECTION("Score, depth, bound and move") {
+    table.Store(0x1234, 7, LOWER_BOUND, -98765, 18, 3);
+    REQUIRE(table.Probe(0x1234, entry));
+    REQUIRE(entry.key == 0x1234);
+    REQUIRE(entry.score == -98765);
+    REQUIRE(entry.depth == 7);
+    REQUIRE(entry.bound == LOWER_BOUND);
+    REQUIRE(entry.row_index == 18);
+    REQUIRE(entry.column_index == 3);
+  }
+
+  SECTION("Scores at both ends of the window") {
+    table.Store(0x2001, 1, EXACT, INT_MAX, 0, 0);
+    REQUIRE(table.Probe(0x2001, entry));
+    REQUIRE(entry.score == INT_MAX);
+    table.Store(0x2002, 1, EXACT, -INT_MAX, 0, 0);
+    REQUIRE(table.Probe(0x2002, entry));
+    REQUIRE(entry.score == -INT_MAX);
+  }
+
+  SECTION("Position without best move") {
+    table.Store(0x3001, 2, UPPER_BOUND, 0, -1, -1);
+    REQUIRE(table.Probe(0x3001, entry));
+    REQUIRE(entry.bound == UPPER_BOUND);
+    REQUIRE(entry.row_index == -1);
+    REQUIRE(entry.column_index == -1);
+  }
+
+  SECTION("Depth is capped") {
+    table.Store(0x4001, 100, EXACT, 5, 1, 1);
+    REQUIRE(table.Probe(0x4001, entry));
+    REQUIRE(entry.depth == 63);
+  }
+}
+
+TEST_CASE("Other positions of the same slot miss", "[transposition]") {
+  TranspositionTable table(1024);
+  TranspositionEntry entry{};
+  table.Store(0x5001, 3, EXACT, 42, 9, 9);
+  // same index bits, different key
+  REQUIRE_FALSE(table.Probe(0x5001 + 1024, entry));
+  REQUIRE(table.GetMisses() == 1);
+  REQUIRE(table.Probe(0x5001, entry));
+  REQUIRE(table.GetHits() == 1);
+}
+
+TEST_CASE("Table size is rounded down to power of two", "[transposition]") {
+  TranspositionTable table(1000);
+  REQUIRE(table.GetSize() == 512);
+}
@@ -0,0 +1,113 @@
+//
+// Tests of zobrist hashing and board symmetries.
+//
+
+#include <mylibrary/Zobrist.h>
+
+#include <catch2/catch.hpp>
+#include <random>
+
+namespace {
+// standard board size
+const int SIZE = Game::BOARD_SIZE;
+
+/**
+ * fill a board with random stones
+ * @param board board status reference
+ * @param random random generator
+ */
+void FillRandom(Stone board[SIZE][SIZE], std::mt19937& random) {
+  std::uniform_int_distribution<int> pick(0, 5);
+  for (int x = 0; x < SIZE; x++)
+    for (int y = 0; y < SIZE; y++)
+      board[x][y] = pick(random) < 2 ? static_cast<Stone>(pick(random) % 2 + 1)
+                                     : Stone::EMPTY;
+}
+
+/**
+ * map every stone of a board by a symmetry
+ * @param symmetry symmetry index
+ * @param board board status
+ * @param image mapped board reference
+ */
+void TransformBoard(int symmetry, Stone board[SIZE][SIZE],
+                    Stone image[SIZE][SIZE]) {
+  for (int x = 0; x < SIZE; x++) {
+    for (int y = 0; y < SIZE; y++) {
+      int new_x, new_y;
+      Zobrist::Transform(symmetry, x, y, new_x, new_y);
+      image[new_x][new_y] = board[x][y];
+    }
+  }
+}
+}  // namespace
+
+TEST_CASE("Symmetries are inverted by InverseTransform", "[zobrist]") {
+  for (int s = 0; s < SYMMETRY_NUM; s++) {
+    bool mapped[SIZE][SIZE] = {};
+    for (int x = 0; x < SIZE; x++) {
+      for (int y = 0; y < SIZE; y++) {
+        int new_x, new_y, old_x, old_y;
+        Zobrist::Transform(s, x, y, new_x, new_y);
+        REQUIRE(new_x >= 0);
+        REQUIRE(new_x < SIZE);
+        REQUIRE(new_y >= 0);
+        REQUIRE(new_y < SIZE);
+        // no two grids are mapped to the same grid
+        REQUIRE_FALSE(mapped[new_x][new_y]);
+        mapped[new_x][new_y] = true;
+        Zobrist::InverseTransform(s, new_x, new_y, old_x, old_y);
+        REQUIRE(old_x == x);
+        REQUIRE(old_y == y);
+      }
+    }
+  }
+}
+
+TEST_CASE("Symmetric boards share the canonical hash", "[zobrist]") {
+  std::mt19937 random(7);
+  for (int round = 0; round < 10; round++) {
+    Stone board[SIZE][SIZE];
+    FillRandom(board, random);
+    int symmetry;
+    uint64_t canonical = Zobrist::CanonicalHash(board, symmetry);
+    // the returned symmetry maps the board to the image with that hash
+    Stone image[SIZE][SIZE];
+    TransformBoard(symmetry, board, image);
+    REQUIRE(Zobrist::Hash(image) == canonical);
+    for (int s = 0; s < SYMMETRY_NUM; s++) {
+      TransformBoard(s, board, image);
+      int image_symmetry;
+      REQUIRE(Zobrist::CanonicalHash(image, image_symmetry) == canonical);
+    }
+  }
+}
+
+TEST_CASE("Incremental symmetric hashes equal hashing from scratch",
+          "[zobrist]") {
+  std::mt19937 random(11);
+  Stone board[SIZE][SIZE] = {};
+  SymmetricHash hash;
+  hash.Init(board);
+  std::uniform_int_distribution<int> pick(0, SIZE - 1);
+  for (int ply = 0; ply < 100; ply++) {
+    int x = pick(random), y = pick(random);
+    // place a stone on an empty grid, remove it otherwise
+    if (board[x][y] == Stone::EMPTY) {
+      board[x][y] = ply % 2 == 0 ? Stone::BLACK : Stone::WHITE;
+      hash.Toggle(x, y, board[x][y]);
+    } else {
+      hash.Toggle(x, y, board[x][y]);
+      board[x][y] = Stone::EMPTY;
+    }
+    SymmetricHash full;
+    full.Init(board);
+    for (int s = 0; s < SYMMETRY_NUM; s++)
+      REQUIRE(hash.hashes[s] == full.hashes[s]);
+    REQUIRE(hash.Hash() == Zobrist::Hash(board));
+    int symmetry, full_symmetry;
+    REQUIRE(hash.Canonical(symmetry) ==
+            Zobrist::CanonicalHash(board, full_symmetry));
+    REQUIRE(symmetry == full_symmetry);
+  }
+}
@@ -0,0 +1,181 @@
+//
+// Builds an opening book from self-play of the search engine.
+//
+// usage: book-builder <book file> [games] [plies] [depth] [threads]
+//
+// every worker thread plays games with its own engine. Each position of the
+// first plies is searched once, its move is stored by the canonical hash of
+// the board. Early moves are sometimes replaced by a random grid next to the
+// stones, so that games branch into different openings. An existing book
+// file is extended, positions already in it are not searched again.
+//
+
+#include <mylibrary/Game.h>
+#include <mylibrary/MiniMax.h>
+#include <mylibrary/OpeningBook.h>
+#include <mylibrary/Zobrist.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+// default number of self-play games
+const int DEFAULT_GAMES = 64;
+// default number of plies of each game stored in the book
+const int DEFAULT_PLIES = 10;
+// default search depth of book moves, deeper than the interactive search
+const int DEFAULT_DEPTH = 5;
+// transposition table entries of each worker engine
+const size_t WORKER_TABLE_SIZE = 1U << 18U;
+
+/**
+ * book being built, shared by all worker threads
+ */
+struct SharedBook {
+  std::mutex lock;
+  std::unordered_map<uint64_t, BookEntry> entries;
+  std::atomic<int> next_game{0};
+};
+
+/**
+ * pick a random empty grid next to a stone, the center on empty board
+ * @param game current game
+ * @param random random generator
+ * @param x row index reference
+ * @param y column index reference
+ */
+void PickRandomMove(Game& game, std::mt19937& random, int& x, int& y) {
+  std::vector<int> grids;
+  for (int i = 0; i < Game::BOARD_SIZE; i++) {
+    for (int j = 0; j < Game::BOARD_SIZE; j++) {
+      if (game.mChessStatus[i][j] != Stone::EMPTY) continue;
+      bool near = false;
+      for (int dx = -1; dx <= 1 && !near; dx++)
+        for (int dy = -1; dy <= 1 && !near; dy++)
+          near = game.GetStatus(i + dx, j + dy) == Stone::BLACK ||
+                 game.GetStatus(i + dx, j + dy) == Stone::WHITE;
+      if (near) grids.push_back(i * Game::BOARD_SIZE + j);
+    }
+  }
+  if (grids.empty()) {
+    x = Game::BOARD_SIZE / 2;
+    y = Game::BOARD_SIZE / 2;
+    return;
+  }
+  std::uniform_int_distribution<size_t> pick(0, grids.size() - 1);
+  int grid = grids[pick(random)];
+  x = grid / Game::BOARD_SIZE;
+  y = grid % Game::BOARD_SIZE;
+}
+
+/**
+ * play self-play games until all are taken by workers
+ * @param book shared book
+ * @param games total number of games
+ * @param plies number of plies of each game stored in the book
+ * @param depth search depth of book moves
+ */
+void PlayGames(SharedBook* book, int games, int plies, int depth) {
+  std::unique_ptr<AlphaBetaAlgorithm> engine(
+      new AlphaBetaAlgorithm(WORKER_TABLE_SIZE));
+  SearchLimits limits;
+  limits.max_depth = depth;
+  engine->SetSearchLimits(limits);
+  for (int n = book->next_game++; n < games; n = book->next_game++) {
+    // the same game number always plays the same game
+    std::mt19937 random(static_cast<unsigned>(n));
+    engine->SetRandomSeed(static_cast<unsigned>(n));
+    std::bernoulli_distribution explore(0.5);
+    Game game;
+    for (int ply = 0; ply < plies; ply++) {
+      Stone player = game.GetRole();
+      int symmetry;
+      uint64_t key = OpeningBook::GetKey(game.mChessStatus, player, symmetry);
+      int x = -1, y = -1;
+      bool found = false;
+      {
+        std::lock_guard<std::mutex> guard(book->lock);
+        auto entry = book->entries.find(key);
+        if (entry != book->entries.end()) {
+          Zobrist::InverseTransform(symmetry, entry->second.row_index,
+                                    entry->second.column_index, x, y);
+          found = true;
+        }
+      }
+      // two workers may search the same position, the first result stays
+      if (!found && ply > 0) {
+        engine->AlphaBetaGo(game.mChessStatus, player, x, y);
+        SearchStatistics statistics = engine->GetStatistics();
+        BookEntry entry{};
+        int book_x, book_y;
+        Zobrist::Transform(symmetry, x, y, book_x, book_y);
+        entry.key = key;
+        entry.value = statistics.best_value;
+        entry.row_index = static_cast<uint8_t>(book_x);
+        entry.column_index = static_cast<uint8_t>(book_y);
+        entry.depth = static_cast<uint16_t>(statistics.completed_depth);
+        std::lock_guard<std::mutex> guard(book->lock);
+        book->entries.emplace(key, entry);
+      }
+      // the first half of the opening branches out
+      if (ply == 0 || (ply < plies / 2 && explore(random)))
+        PickRandomMove(game, random, x, y);
+      if (game.Play(x, y) != Stone::EMPTY) break;
+    }
+    std::lock_guard<std::mutex> guard(book->lock);
+    std::cout << "game " << n + 1 << "/" << games << ", "
+              << book->entries.size() << " positions" << std::endl;
+  }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::cerr << "usage: " << argv[0]
+              << " <book file> [games] [plies] [depth] [threads]" << std::endl;
+    return 1;
+  }
+  std::string path = argv[1];
+  int games = argc > 2 ? std::atoi(argv[2]) : DEFAULT_GAMES;
+  int plies = argc > 3 ? std::atoi(argv[3]) : DEFAULT_PLIES;
+  int depth = argc > 4 ? std::atoi(argv[4]) : DEFAULT_DEPTH;
+  int threads = argc > 5
+                    ? std::atoi(argv[5])
+                    : static_cast<int>(std::thread::hardware_concurrency());
+  if (threads <= 0) threads = THREAD_NUM;
+  SharedBook book;
+  // extend the existing book, it is unmapped before being written again
+  {
+    OpeningBook existing;
+    if (existing.Open(path, Game::BOARD_SIZE, Game::WINNING_THRESHOLD)) {
+      for (size_t k = 0; k < existing.GetSize(); k++)
+        book.entries.emplace(existing.GetEntries()[k].key,
+                             existing.GetEntries()[k]);
+      std::cout << "extending " << existing.GetSize() << " positions"
+                << std::endl;
+    }
+  }
+  std::vector<std::thread> workers;
+  for (int k = 0; k < threads; k++)
+    workers.emplace_back(PlayGames, &book, games, plies, depth);
+  for (auto& worker : workers) worker.join();
+  std::vector<BookEntry> entries;
+  entries.reserve(book.entries.size());
+  for (auto& entry : book.entries) entries.push_back(entry.second);
+  if (!OpeningBook::Write(path, entries, Game::BOARD_SIZE,
+                          Game::WINNING_THRESHOLD)) {
+    std::cerr << "can not write " << path << std::endl;
+    return 1;
+  }
+  std::cout << "wrote " << entries.size() << " positions to " << path
+            << std::endl;
+  return 0;
+}
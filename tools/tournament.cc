@@ -0,0 +1,341 @@
+//
+// Plays players against each other without the user interface.
+//
+// usage: tournament <player a> <player b> [games] [depth] [threads]
+//                   [board size]
+//
+// players are ab (AlphaBetaGo), abmt (AlphaBetaGoMT), simple
+// (SimpleAutoPlayer::SimpleStrategy, standard board only) and random. Worker
+// threads play games in parallel, each with its own players. Player a takes
+// black in even games and white in odd games, and the first moves are random
+// grids near the center, so that players without randomness do not repeat
+// one game. Reports wins, draws and losses of player a, the move latency of
+// both players and the search speed of engines.
+//
+
+#include <mylibrary/Game.h>
+#include <mylibrary/MiniMax.h>
+#include <mylibrary/SimpleAutoPlayer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+// default number of games
+const int DEFAULT_GAMES = 100;
+// random moves at the start of every game
+const int OPENING_PLIES = 2;
+// distance to the center of random opening moves
+const int OPENING_RANGE = 2;
+// transposition table entries of each engine
+const size_t WORKER_TABLE_SIZE = 1U << 18U;
+
+/**
+ * move strategy of a player
+ */
+enum PlayerType { ALPHA_BETA, ALPHA_BETA_MT, SIMPLE, RANDOM };
+// command line name of each player type
+const char* const PLAYER_NAMES[] = {"ab", "abmt", "simple", "random"};
+
+/**
+ * moves of one player over all games
+ */
+struct PlayerRecord {
+  std::vector<double> latencies_ms;  // time taken by each move
+  long long nodes = 0;               // nodes searched by the engine
+  double search_ms = 0;              // time taken by engine moves
+};
+
+/**
+ * tournament settings and results, shared by all worker threads. Player
+ * index 0 is player a, 1 is player b
+ */
+struct Tournament {
+  PlayerType types[2];
+  int games;
+  int depth;
+  std::atomic<int> next_game{0};
+  std::mutex lock;
+  // results of player a
+  int wins = 0;
+  int draws = 0;
+  int losses = 0;
+  PlayerRecord records[2];
+};
+
+/**
+ * @param name command line name
+ * @param type player type reference, updated if the name is known
+ * @return whether the name is a player type
+ */
+bool ParsePlayer(const std::string& name, PlayerType& type) {
+  for (int k = 0; k < 4; k++) {
+    if (name == PLAYER_NAMES[k]) {
+      type = static_cast<PlayerType>(k);
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * simple strategy on the standard board
+ * @return whether a move is found
+ */
+bool PlaySimple(Stone board[Game::BOARD_SIZE][Game::BOARD_SIZE], Stone player,
+                int& x, int& y) {
+  SimpleAutoPlayer::SimpleStrategy(board, player, x, y);
+  return true;
+}
+
+/**
+ * simple strategy is only written for the standard board, other boards are
+ * rejected before any game starts
+ * @return false
+ */
+template <int N>
+bool PlaySimple(Stone (*)[N], Stone, int&, int&) {
+  return false;
+}
+
+/**
+ * pick a random empty grid, either anywhere or near the center
+ * @param board board status
+ * @param random random generator
+ * @param range distance to the center, or N for the whole board
+ * @param x row index reference
+ * @param y column index reference
+ * @return whether an empty grid is found
+ */
+template <int N>
+bool PickRandomMove(Stone board[N][N], std::mt19937& random, int range,
+                    int& x, int& y) {
+  std::vector<int> grids;
+  for (int i = std::max(N / 2 - range, 0); i <= std::min(N / 2 + range, N - 1);
+       i++) {
+    for (int j = std::max(N / 2 - range, 0);
+         j <= std::min(N / 2 + range, N - 1); j++)
+      if (board[i][j] == Stone::EMPTY) grids.push_back(i * N + j);
+  }
+  if (grids.empty()) return false;
+  std::uniform_int_distribution<size_t> pick(0, grids.size() - 1);
+  int grid = grids[pick(random)];
+  x = grid / N;
+  y = grid % N;
+  return true;
+}
+
+/**
+ * play games until all are taken by workers, then merge the results
+ * @tparam N board size
+ * @tparam K number of stones in a row to win
+ * @param tournament shared settings and results
+ */
+template <int N, int K>
+void PlayGames(Tournament* tournament) {
+  std::unique_ptr<BasicAlphaBetaAlgorithm<N, K>> engines[2];
+  for (int p = 0; p < 2; p++) {
+    if (tournament->types[p] != ALPHA_BETA &&
+        tournament->types[p] != ALPHA_BETA_MT)
+      continue;
+    engines[p].reset(new BasicAlphaBetaAlgorithm<N, K>(WORKER_TABLE_SIZE));
+    SearchLimits limits;
+    limits.max_depth = tournament->depth;
+    engines[p]->SetSearchLimits(limits);
+  }
+  PlayerRecord records[2];
+  int wins = 0, draws = 0, losses = 0;
+  for (int n = tournament->next_game++; n < tournament->games;
+       n = tournament->next_game++) {
+    // the same game number always opens the same way
+    std::mt19937 random(static_cast<unsigned>(n));
+    BasicGame<N, K> game;
+    // index of the player holding black
+    int black = n % 2;
+    Stone winner = Stone::EMPTY;
+    for (int ply = 0; ply < N * N && game.GetRole() != Stone::EMPTY; ply++) {
+      Stone stone = game.GetRole();
+      int p = stone == Stone::BLACK ? black : 1 - black;
+      PlayerType type = tournament->types[p];
+      int x = -1, y = -1;
+      bool moved;
+      if (ply < OPENING_PLIES) {
+        moved = PickRandomMove<N>(game.mChessStatus, random, OPENING_RANGE, x,
+                                  y);
+      } else {
+        auto start = std::chrono::steady_clock::now();
+        if (type == ALPHA_BETA)
+          moved = engines[p]->AlphaBetaGo(game.mChessStatus, stone, x, y) != 0;
+        else if (type == ALPHA_BETA_MT)
+          moved =
+              engines[p]->AlphaBetaGoMT(game.mChessStatus, stone, x, y) != 0;
+        else if (type == SIMPLE)
+          moved = PlaySimple(game.mChessStatus, stone, x, y);
+        else
+          moved = PickRandomMove<N>(game.mChessStatus, random, N, x, y);
+        double ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+        records[p].latencies_ms.push_back(ms);
+        if (engines[p]) {
+          records[p].nodes += engines[p]->GetStatistics().nodes;
+          records[p].search_ms += ms;
+        }
+      }
+      if (!moved) break;
+      // an occupied grid forfeits the game
+      if (game.GetStatus(x, y) != Stone::EMPTY) {
+        winner = stone == Stone::BLACK ? Stone::WHITE : Stone::BLACK;
+        break;
+      }
+      winner = game.Play(x, y);
+    }
+    if (winner == Stone::EMPTY)
+      draws++;
+    else if ((winner == Stone::BLACK) == (black == 0))
+      wins++;
+    else
+      losses++;
+  }
+  std::lock_guard<std::mutex> guard(tournament->lock);
+  tournament->wins += wins;
+  tournament->draws += draws;
+  tournament->losses += losses;
+  for (int p = 0; p < 2; p++) {
+    PlayerRecord& record = tournament->records[p];
+    record.latencies_ms.insert(record.latencies_ms.end(),
+                               records[p].latencies_ms.begin(),
+                               records[p].latencies_ms.end());
+    record.nodes += records[p].nodes;
+    record.search_ms += records[p].search_ms;
+  }
+}
+
+/**
+ * play the tournament on worker threads
+ * @tparam N board size
+ * @tparam K number of stones in a row to win
+ * @param tournament settings, filled with results
+ * @param threads number of worker threads
+ */
+template <int N, int K>
+void RunTournament(Tournament* tournament, int threads) {
+  std::vector<std::thread> workers;
+  for (int k = 0; k < threads; k++)
+    workers.emplace_back(PlayGames<N, K>, tournament);
+  for (auto& worker : workers) worker.join();
+}
+
+/**
+ * @param sorted sorted latencies
+ * @param fraction fraction of moves at or below the returned latency
+ * @return latency percentile
+ */
+double Percentile(const std::vector<double>& sorted, double fraction) {
+  size_t index =
+      static_cast<size_t>(fraction * static_cast<double>(sorted.size()));
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+
+/**
+ * print results of the tournament
+ * @param tournament finished tournament
+ * @param seconds wall-clock time of the tournament
+ */
+void Report(Tournament& tournament, double seconds) {
+  int games = tournament.wins + tournament.draws + tournament.losses;
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "a (" << PLAYER_NAMES[tournament.types[0]] << ") wins "
+            << tournament.wins << ", draws " << tournament.draws
+            << ", losses " << tournament.losses << " against b ("
+            << PLAYER_NAMES[tournament.types[1]] << "), win rate "
+            << (games > 0 ? 100.0 * tournament.wins / games : 0.0) << "%"
+            << std::endl;
+  std::cout << games << " games in " << seconds << " s, "
+            << games / seconds << " games/s" << std::endl;
+  std::cout << std::setprecision(2);
+  for (int p = 0; p < 2; p++) {
+    std::vector<double>& latencies = tournament.records[p].latencies_ms;
+    std::cout << (p == 0 ? "a" : "b") << " ("
+              << PLAYER_NAMES[tournament.types[p]]
+              << "): " << latencies.size() << " moves";
+    if (!latencies.empty()) {
+      std::sort(latencies.begin(), latencies.end());
+      double total = 0;
+      for (double latency : latencies) total += latency;
+      std::cout << ", ms avg " << total / static_cast<double>(latencies.size())
+                << " p50 " << Percentile(latencies, 0.5) << " p90 "
+                << Percentile(latencies, 0.9) << " p99 "
+                << Percentile(latencies, 0.99) << " max " << latencies.back();
+    }
+    if (tournament.records[p].search_ms > 0)
+      std::cout << ", " << std::setprecision(0)
+                << static_cast<double>(tournament.records[p].nodes) /
+                       tournament.records[p].search_ms
+                << " knodes/s" << std::setprecision(2);
+    std::cout << std::endl;
+  }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  Tournament tournament;
+  if (argc < 3 || !ParsePlayer(argv[1], tournament.types[0]) ||
+      !ParsePlayer(argv[2], tournament.types[1])) {
+    std::cerr << "usage: " << argv[0]
+              << " <player a> <player b> [games] [depth] [threads]"
+                 " [board size]"
+              << std::endl
+              << "players: ab, abmt, simple, random" << std::endl;
+    return 1;
+  }
+  tournament.games = argc > 3 ? std::atoi(argv[3]) : DEFAULT_GAMES;
+  tournament.depth = argc > 4 ? std::atoi(argv[4]) : SEARCH_DEPTH;
+  // a multi-thread engine already uses every core
+  bool multi_thread = tournament.types[0] == ALPHA_BETA_MT ||
+                      tournament.types[1] == ALPHA_BETA_MT;
+  int threads =
+      argc > 5 ? std::atoi(argv[5])
+               : multi_thread
+                     ? 1
+                     : static_cast<int>(std::thread::hardware_concurrency());
+  if (threads <= 0) threads = THREAD_NUM;
+  int board_size = argc > 6 ? std::atoi(argv[6]) : Game::BOARD_SIZE;
+  if (board_size != Game::BOARD_SIZE &&
+      (tournament.types[0] == SIMPLE || tournament.types[1] == SIMPLE)) {
+    std::cerr << "simple player only plays on the " << Game::BOARD_SIZE
+              << "x" << Game::BOARD_SIZE << " board" << std::endl;
+    return 1;
+  }
+  std::cout << tournament.games << " games on " << board_size << "x"
+            << board_size << " board, depth " << tournament.depth << ", "
+            << threads << " threads" << std::endl;
+  auto start = std::chrono::steady_clock::now();
+  bool found = false;
+#define RUN_VARIANT(N, K)                    \
+  if (board_size == (N)) {                   \
+    RunTournament<N, K>(&tournament, threads); \
+    found = true;                            \
+  }
+  FOR_EACH_BOARD_VARIANT(RUN_VARIANT)
+#undef RUN_VARIANT
+  if (!found) {
+    std::cerr << "board size " << board_size << " is not supported"
+              << std::endl;
+    return 1;
+  }
+  Report(tournament, std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count());
+  return 0;
+}